@@ -0,0 +1,309 @@
+/* r2replay - deterministic replay and shrinking of fuzzed crash reproducers */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <r_core.h>
+
+/*
+ * Reproducing a bins/fuzzed regression with `r2 -A` means re-running the
+ * whole analysis for every attempt. Instead, r2replay loads the file once and
+ * uses fork() as a snapshot of the in-process RCore/RIO state:
+ *
+ *  1. record: every analysis step runs in a child forked from the state left
+ *     by the previous step, so the step that crashes (or hangs) is found
+ *     after a single pass and the parent still holds the state right before
+ *     it.
+ *  2. the command sequence is minimized by replaying subsets of the steps
+ *     from the snapshot taken just after loading the file.
+ *  3. the file is shrunk by removing chunks while the crash still reproduces,
+ *     each candidate is loaded and replayed in a forked child.
+ *
+ * The shrunk file is written to -o and a db test entry to stdout. Built with
+ * ASAN every attempt takes milliseconds instead of a full r2 startup.
+ */
+
+#define MAX_STEPS 64
+
+/* roughly the passes run by aaa, followed by aaa itself */
+static const char *default_steps[] = {
+	"aa", "aar", "aac", "aan", "aaa", NULL
+};
+
+typedef struct {
+	ut8 *buf;
+	int size;
+	const char *evals[MAX_STEPS];
+	int nevals;
+	const char *steps[MAX_STEPS];
+	int nsteps;
+	int timeout;
+	int max_tries;
+	int tries;
+	int crash_sig;
+} Replay;
+
+/* report ASAN errors as SIGABRT, they are then handled like any other crash */
+const char *__asan_default_options(void) {
+	return "abort_on_error=1:detect_leaks=0";
+}
+
+static int crash_signal(int status) {
+	if (WIFSIGNALED (status)) {
+		return WTERMSIG (status);
+	}
+	return (WIFEXITED (status) && WEXITSTATUS (status))? SIGABRT: 0;
+}
+
+/* same sequence as the test printed by emit_test: FILE=malloc://size, the evals, wff and oba */
+static RCore *load(Replay *rp, const ut8 *buf, int size) {
+	int i;
+	RCore *core = r_core_new ();
+	if (!core) {
+		return NULL;
+	}
+	r_core_cmd0 (core, "e scr.interactive=false");
+	r_core_cmdf (core, "o malloc://%d", size);
+	r_core_cmd0 (core, "e scr.null=true");
+	for (i = 0; i < rp->nevals; i++) {
+		r_core_cmdf (core, "e %s", rp->evals[i]);
+	}
+	r_io_write_at (core->io, 0, buf, size);
+	r_core_cmd0 (core, "oba 0");
+	return core;
+}
+
+/* runs the steps in a child forked from the current state, returns the crash signal or 0 */
+static int try_steps(Replay *rp, RCore *core, const ut8 *buf, int size, const int *steps, int n) {
+	int i, status;
+	pid_t pid;
+	rp->tries++;
+	pid = fork ();
+	if (pid == -1) {
+		return 0;
+	}
+	if (!pid) {
+		alarm (rp->timeout);
+		if (!core) {
+			core = load (rp, buf, size);
+		}
+		for (i = 0; i < n; i++) {
+			r_core_cmd0 (core, rp->steps[steps[i]]);
+		}
+		_exit (0);
+	}
+	if (waitpid (pid, &status, 0) == -1) {
+		return 0;
+	}
+	return crash_signal (status);
+}
+
+/* returns the index of the crashing step, -1 if the steps run cleanly */
+static int record(Replay *rp, RCore *core) {
+	// the crash is seen by the parent of the crashing step, which can be any process of the chain
+	int *crash = mmap (NULL, 2 * sizeof (int), PROT_READ | PROT_WRITE,
+		MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	int i, status, res;
+	bool top = true;
+	pid_t pid;
+	if (crash == MAP_FAILED) {
+		return -1;
+	}
+	crash[0] = -1;
+	crash[1] = 0;
+	for (i = 0; i < rp->nsteps; i++) {
+		pid = fork ();
+		if (pid == -1) {
+			break;
+		}
+		if (!pid) {
+			// the child runs the step and becomes the snapshot for the next one
+			alarm (rp->timeout);
+			r_core_cmd0 (core, rp->steps[i]);
+			alarm (0);
+			top = false;
+			continue;
+		}
+		if (waitpid (pid, &status, 0) != -1 && crash_signal (status) && crash[0] == -1) {
+			crash[0] = i;
+			crash[1] = crash_signal (status);
+		}
+		break;
+	}
+	if (!top) {
+		_exit (0);
+	}
+	rp->tries += rp->nsteps;
+	rp->crash_sig = crash[1];
+	res = crash[0];
+	munmap (crash, 2 * sizeof (int));
+	return res;
+}
+
+/* drops the steps before the crashing one which are not needed to reproduce it */
+static int minimize_steps(Replay *rp, RCore *core, int *seq, int n) {
+	int cand[MAX_STEPS];
+	int i, j, k;
+	for (i = 0; i < n - 1 && rp->tries < rp->max_tries; ) {
+		for (j = k = 0; j < n; j++) {
+			if (j != i) {
+				cand[k++] = seq[j];
+			}
+		}
+		if (try_steps (rp, core, NULL, 0, cand, k) == rp->crash_sig) {
+			memcpy (seq, cand, k * sizeof (int));
+			n = k;
+		} else {
+			i++;
+		}
+	}
+	return n;
+}
+
+static void shrink_file(Replay *rp, const int *seq, int n) {
+	ut8 *cand = malloc (rp->size);
+	int chunk, off;
+	if (!cand) {
+		return;
+	}
+	for (chunk = rp->size / 2; chunk > 0 && rp->tries < rp->max_tries; chunk /= 2) {
+		for (off = 0; off < rp->size && rp->tries < rp->max_tries; ) {
+			int len = R_MIN (chunk, rp->size - off);
+			if (len == rp->size) {
+				break;
+			}
+			memcpy (cand, rp->buf, off);
+			memcpy (cand + off, rp->buf + off + len, rp->size - off - len);
+			if (try_steps (rp, NULL, cand, rp->size - len, seq, n) == rp->crash_sig) {
+				memcpy (rp->buf, cand, rp->size - len);
+				rp->size -= len;
+			} else {
+				off += len;
+			}
+		}
+	}
+	free (cand);
+}
+
+/* the file is loaded as in load(), so the test replays exactly what was shrunk */
+static void emit_test(Replay *rp, const char *name, const int *seq, int n) {
+	int i;
+	printf ("NAME=%s replay\n", name);
+	printf ("FILE=malloc://%d\n", rp->size);
+	printf ("BROKEN=1\n");
+	printf ("CMDS=<<EXPECT\n");
+	printf ("e scr.null=true\n");
+	for (i = 0; i < rp->nevals; i++) {
+		printf ("e %s\n", rp->evals[i]);
+	}
+	printf ("wff ../bins/fuzzed/%s\n", name);
+	printf ("oba 0\n");
+	for (i = 0; i < n; i++) {
+		printf ("%s\n", rp->steps[seq[i]]);
+	}
+	printf ("e scr.null=false\n");
+	printf ("?e done\n");
+	printf ("EXPECT=<<RUN\n");
+	printf ("done\n");
+	printf ("RUN\n");
+}
+
+static int usage(int v) {
+	printf ("Usage: r2replay [-c cmd] [-e k=v] [-t secs] [-n tries] [-o out] [file]\n"
+		" -c cmd    analysis step to replay (can be repeated, defaults to aa,aar,aac,aan,aaa)\n"
+		" -e k=v    eval config var before loading the bin (can be repeated)\n"
+		" -t secs   consider a step hanging after secs seconds (60)\n"
+		" -n tries  maximum number of replays used to shrink (2000)\n"
+		" -o out    where to write the shrunk file (<file>.min)\n");
+	return v;
+}
+
+int main(int argc, char **argv) {
+	Replay rp = {0};
+	const char *out = NULL;
+	char *outf = NULL;
+	int seq[MAX_STEPS];
+	int c, i, n, crash;
+	RCore *core;
+
+	rp.timeout = 60;
+	rp.max_tries = 2000;
+	while ((c = getopt (argc, argv, "c:e:t:n:o:h")) != -1) {
+		switch (c) {
+		case 'c':
+			if (rp.nsteps < MAX_STEPS) {
+				rp.steps[rp.nsteps++] = optarg;
+			}
+			break;
+		case 'e':
+			if (rp.nevals < MAX_STEPS) {
+				rp.evals[rp.nevals++] = optarg;
+			}
+			break;
+		case 't':
+			rp.timeout = atoi (optarg);
+			break;
+		case 'n':
+			rp.max_tries = atoi (optarg);
+			break;
+		case 'o':
+			out = optarg;
+			break;
+		case 'h':
+			return usage (0);
+		default:
+			return usage (1);
+		}
+	}
+	if (optind != argc - 1) {
+		return usage (1);
+	}
+	if (!rp.nsteps) {
+		for (i = 0; default_steps[i]; i++) {
+			rp.steps[rp.nsteps++] = default_steps[i];
+		}
+	}
+	rp.buf = (ut8 *)r_file_slurp (argv[optind], &rp.size);
+	if (!rp.buf) {
+		eprintf ("Cannot open %s\n", argv[optind]);
+		return 1;
+	}
+
+	// loading the file may be the crash point already
+	rp.crash_sig = try_steps (&rp, NULL, rp.buf, rp.size, seq, 0);
+	if (rp.crash_sig) {
+		eprintf ("Crash while loading the file (signal %d)\n", rp.crash_sig);
+		n = 0;
+	} else {
+		core = load (&rp, rp.buf, rp.size);
+		crash = record (&rp, core);
+		if (crash == -1) {
+			eprintf ("No crash after %d steps\n", rp.nsteps);
+			r_core_free (core);
+			free (rp.buf);
+			return 1;
+		}
+		eprintf ("Crash at step %d (%s), signal %d\n", crash, rp.steps[crash], rp.crash_sig);
+		for (n = 0; n <= crash; n++) {
+			seq[n] = n;
+		}
+		n = minimize_steps (&rp, core, seq, n);
+		r_core_free (core);
+	}
+	i = rp.size;
+	shrink_file (&rp, seq, n);
+	eprintf ("Shrunk %d -> %d bytes, %d steps, %d replays\n", i, rp.size, n, rp.tries);
+
+	if (!out) {
+		out = outf = r_str_newf ("%s.min", argv[optind]);
+	}
+	r_file_dump (out, rp.buf, rp.size, false);
+	emit_test (&rp, r_file_basename (out), seq, n);
+	free (outf);
+	free (rp.buf);
+	return 0;
+}
@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+#
+#
+# db_cmds
+# =======
+#
+# Extracts the CMDS/CMDS64 scripts of the new/db test files and turns them
+# into seeds for the command language fuzz target:
+#
+#  * one seed corpus file per test script (-o DIR)
+#  * a vocabulary of unique command statements, one per line (-v FILE),
+#    which is loaded by cmd_fuzz to drive its grammar aware mutator.
+#
+# Statements using commands that reach outside of the process (shell, files,
+# debugger, network) are dropped, the fuzz target runs in sandbox mode anyway
+# but there is no point in wasting executions on them.
+#
+# Usage:
+#   db_cmds.py -o corpora/cmd_fuzz_seed_corpus -v cmd_fuzz.cmds ../../new/db/cmd
+
+import os
+import sys
+import base64
+import hashlib
+import argparse
+
+SKIP_PREFIXES = ('!', '#!', 'o', 'd', 'q', 'V', 'v', '=', '&', 'T', 'H', 'wf', 'wt', 'rm', 'cd', 'ls', 'env')
+DELIMS = ('\'', '"', '%')
+
+
+def parse_cmds(lines):
+    i = 0
+    while i < len(lines):
+        line = lines[i]
+        eq = line.find('=')
+        if eq == -1:
+            i += 1
+            continue
+        k, v = line[:eq], line[eq + 1:]
+        vt = v.strip()
+        if k == 'CMDS64':
+            yield base64.b64decode(v).decode('utf-8', 'replace')
+        elif k == 'CMDS':
+            if vt.startswith('<<'):
+                end = vt[2:]
+                i += 1
+                script = ''
+                while i < len(lines) and not lines[i].startswith(end):
+                    script += lines[i] + '\n'
+                    i += 1
+                yield script
+            elif vt and vt[0] in DELIMS:
+                delim = vt[0]
+                start = v.find(delim)
+                stop = v.find(delim, start + 1)
+                if stop != -1:
+                    yield v[start + 1:stop] + '\n'
+                else:
+                    script = v[start + 1:] + '\n'
+                    i += 1
+                    while i < len(lines) and lines[i].find(delim) == -1:
+                        script += lines[i] + '\n'
+                        i += 1
+                    if i < len(lines):
+                        script += lines[i][:lines[i].find(delim)]
+                    yield script
+            elif v:
+                yield v + '\n'
+        i += 1
+
+
+def keep(stmt):
+    s = stmt.strip()
+    return len(s) > 0 and not s.startswith(SKIP_PREFIXES)
+
+
+def walk(paths):
+    for p in paths:
+        if os.path.isdir(p):
+            for root, _, files in os.walk(p):
+                for f in sorted(files):
+                    yield os.path.join(root, f)
+        else:
+            yield p
+
+
+def main():
+    ap = argparse.ArgumentParser(description='Extract fuzz seeds from r2r db files')
+    ap.add_argument('-o', dest='corpus', help='seed corpus output directory')
+    ap.add_argument('-v', dest='vocab', help='statement vocabulary output file')
+    ap.add_argument('paths', nargs='+', help='db files or directories')
+    args = ap.parse_args()
+
+    scripts = []
+    for path in walk(args.paths):
+        with open(path, encoding='utf-8', errors='replace') as fd:
+            lines = fd.read().split('\n')
+        for script in parse_cmds(lines):
+            stmts = [s for s in script.split('\n') if keep(s)]
+            if stmts:
+                scripts.append('\n'.join(stmts) + '\n')
+
+    if args.corpus:
+        os.makedirs(args.corpus, exist_ok=True)
+        for script in scripts:
+            data = script.encode('utf-8')
+            name = hashlib.sha1(data).hexdigest()
+            with open(os.path.join(args.corpus, name), 'wb') as fd:
+                fd.write(data)
+
+    if args.vocab:
+        vocab = set()
+        for script in scripts:
+            for stmt in script.split('\n'):
+                stmt = stmt.strip()
+                if stmt:
+                    vocab.add(stmt)
+        with open(args.vocab, 'w', encoding='utf-8') as fd:
+            for stmt in sorted(vocab):
+                fd.write(stmt + '\n')
+
+    print('%d scripts' % len(scripts), file=sys.stderr)
+
+
+if __name__ == '__main__':
+    main()
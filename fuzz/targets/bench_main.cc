@@ -0,0 +1,199 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+// Throughput driver for the fuzz targets.
+//
+// Linked against a target instead of the fuzzing engine, it replays the seed
+// corpus round-robin for a fixed number of executions and appends one JSON
+// object per run to the output file:
+//
+//   {"target":"ia_fuzz","commit":"...","date":...,"runs":10000,
+//    "inputs":412,"secs":12.3,"exec_per_sec":813.0,
+//    "rss_start_kb":51200,"rss_end_kb":60400,"rss_kb_per_1k_execs":920.0,
+//    "slowest":[{"input":"corpora/...","ms":120.5}, ...]}
+//
+// RSS growth is measured after a warm-up pass over the corpus, so it shows
+// the leaks the fuzzers hide with detect_leaks=0.
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *Data, size_t Size);
+extern "C" __attribute__((weak)) int LLVMFuzzerInitialize(int *argc, char ***argv);
+
+// targets with a custom mutator reference this, it is never called here
+extern "C" size_t LLVMFuzzerMutate(uint8_t *Data, size_t Size, size_t MaxSize) {
+	return Size;
+}
+
+typedef struct {
+	std::string path;
+	std::vector<uint8_t> data;
+	double max_ms;
+} BenchInput;
+
+static double now_ms(void) {
+	struct timespec ts;
+	clock_gettime (CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static long rss_kb(void) {
+	long pages = 0, rss = 0;
+	FILE *fd = fopen ("/proc/self/statm", "r");
+	if (fd) {
+		if (fscanf (fd, "%ld %ld", &pages, &rss) != 2) {
+			rss = 0;
+		}
+		fclose (fd);
+	}
+	return rss * (sysconf (_SC_PAGESIZE) / 1024);
+}
+
+static bool load_input(std::vector<BenchInput> &inputs, const std::string &path) {
+	BenchInput in;
+	FILE *fd = fopen (path.c_str (), "rb");
+	size_t n;
+	uint8_t buf[4096];
+	if (!fd) {
+		return false;
+	}
+	while ((n = fread (buf, 1, sizeof (buf), fd)) > 0) {
+		in.data.insert (in.data.end (), buf, buf + n);
+	}
+	fclose (fd);
+	in.path = path;
+	in.max_ms = 0;
+	inputs.push_back (in);
+	return true;
+}
+
+static void load_corpus(std::vector<BenchInput> &inputs, const char *path) {
+	struct stat st;
+	struct dirent *de;
+	DIR *dir;
+	if (stat (path, &st) != 0) {
+		return;
+	}
+	if (!S_ISDIR (st.st_mode)) {
+		load_input (inputs, path);
+		return;
+	}
+	dir = opendir (path);
+	if (!dir) {
+		return;
+	}
+	while ((de = readdir (dir))) {
+		if (*de->d_name != '.') {
+			load_input (inputs, std::string (path) + "/" + de->d_name);
+		}
+	}
+	closedir (dir);
+	std::sort (inputs.begin (), inputs.end (), [](const BenchInput &a, const BenchInput &b) {
+		return a.path < b.path;
+	});
+}
+
+static std::string json_escape(const std::string &s) {
+	std::string out;
+	for (char c : s) {
+		if (c == '"' || c == '\\') {
+			out += '\\';
+		}
+		out += c;
+	}
+	return out;
+}
+
+static void usage(const char *argv0) {
+	fprintf (stderr, "Usage: %s [-runs=N] [-top=N] [-o=file] [-commit=id] corpus...\n", argv0);
+}
+
+int main(int argc, char **argv) {
+	std::vector<BenchInput> inputs;
+	const char *out = "bench.jsonl";
+	const char *commit = getenv ("R2_COMMIT");
+	size_t runs = 10000, top = 10, warmup, i;
+	std::string target = argv[0];
+	double start, t, secs;
+	long rss_start, rss_end;
+	FILE *fd;
+	int j;
+
+	for (j = 1; j < argc; j++) {
+		if (!strncmp (argv[j], "-runs=", 6)) {
+			runs = strtoul (argv[j] + 6, NULL, 0);
+		} else if (!strncmp (argv[j], "-top=", 5)) {
+			top = strtoul (argv[j] + 5, NULL, 0);
+		} else if (!strncmp (argv[j], "-o=", 3)) {
+			out = argv[j] + 3;
+		} else if (!strncmp (argv[j], "-commit=", 8)) {
+			commit = argv[j] + 8;
+		} else if (*argv[j] == '-') {
+			usage (argv[0]);
+			return 1;
+		} else {
+			load_corpus (inputs, argv[j]);
+		}
+	}
+	if (inputs.empty () || !runs) {
+		usage (argv[0]);
+		return 1;
+	}
+	target = target.substr (target.find_last_of ('/') + 1);
+	if (target.size () > 6 && !target.compare (target.size () - 6, 6, "_bench")) {
+		target.resize (target.size () - 6);
+	}
+	if (LLVMFuzzerInitialize) {
+		LLVMFuzzerInitialize (&argc, &argv);
+	}
+
+	// one pass over the corpus to let caches and lazy plugin state settle
+	warmup = std::min (inputs.size (), runs);
+	for (i = 0; i < warmup; i++) {
+		LLVMFuzzerTestOneInput (inputs[i].data.data (), inputs[i].data.size ());
+	}
+	rss_start = rss_kb ();
+	start = now_ms ();
+	for (i = 0; i < runs; i++) {
+		BenchInput &in = inputs[i % inputs.size ()];
+		t = now_ms ();
+		LLVMFuzzerTestOneInput (in.data.data (), in.data.size ());
+		t = now_ms () - t;
+		if (t > in.max_ms) {
+			in.max_ms = t;
+		}
+	}
+	secs = (now_ms () - start) / 1000.0;
+	rss_end = rss_kb ();
+
+	std::sort (inputs.begin (), inputs.end (), [](const BenchInput &a, const BenchInput &b) {
+		return a.max_ms > b.max_ms;
+	});
+	fd = fopen (out, "a");
+	if (!fd) {
+		perror (out);
+		return 1;
+	}
+	fprintf (fd, "{\"target\":\"%s\",\"commit\":\"%s\",\"date\":%ld,\"runs\":%zu,\"inputs\":%zu,"
+		"\"secs\":%.3f,\"exec_per_sec\":%.1f,\"rss_start_kb\":%ld,\"rss_end_kb\":%ld,"
+		"\"rss_kb_per_1k_execs\":%.1f,\"slowest\":[",
+		json_escape (target).c_str (), json_escape (commit? commit: "unknown").c_str (),
+		(long)time (NULL), runs, inputs.size (), secs, runs / secs, rss_start, rss_end,
+		(rss_end - rss_start) * 1000.0 / runs);
+	for (i = 0; i < top && i < inputs.size (); i++) {
+		fprintf (fd, "%s{\"input\":\"%s\",\"ms\":%.3f}", i? ",": "",
+			json_escape (inputs[i].path).c_str (), inputs[i].max_ms);
+	}
+	fprintf (fd, "]}\n");
+	fclose (fd);
+	printf ("%s: %.1f exec/s, %+.1f KB RSS per 1k execs, slowest %s (%.1f ms)\n",
+		target.c_str (), runs / secs, (rss_end - rss_start) * 1000.0 / runs,
+		inputs[0].path.c_str (), inputs[0].max_ms);
+	return 0;
+}
@@ -0,0 +1,241 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <random>
+#include <string>
+#include <vector>
+#include <r_core.h>
+
+// Structure-aware fuzz target for the r2 command language.
+//
+// Inputs are r2 scripts, one statement per line. The custom mutator works at
+// the grammar level: it splices statements taken from the vocabulary built by
+// `make cmd_fuzz.cmds` (the CMDS of new/db/cmd) and decorates them with the
+// command separators and modifiers (`;`, `@`, `@@`, `~`, `|`, backticks and
+// `$()`), falling back to byte level mutations on a single statement.
+//
+// Every input runs in a fresh RCore on a malloc:// buffer, so that evals,
+// flags, macros, aliases and maps set by an input never leak into the next
+// one and a saved crashing input reproduces on its own. Sandbox mode is
+// forced on, r2 refuses to disable it once enabled.
+
+#define BUFSZ 4096
+#define MAX_STMTS 64
+
+extern "C" size_t LLVMFuzzerMutate(uint8_t *Data, size_t Size, size_t MaxSize);
+
+static ut8 pristine[BUFSZ];
+static std::vector<std::string> vocab;
+
+static const char *builtin_vocab[] = {
+	"px 32", "pd 4", "pi 2", "p8 8", "pxw 16", "pxq 16", "ps", "pf xxd", "pf.foo dd",
+	"pf.foo.x", "/x 9090", "/ hello", "f foo", "f bar 4 @ 8", "fs *", "f~foo", "fr foo baz",
+	"s +1", "s-", "?e hello", "?v 1+2", "?vi $$", "$a=px 4", "(m x; px $0)", ".(m 4)",
+	"aa", "af", "afl", "ao", "b 64", "wx 9090", "wa nop", "y 4", "yy 8", "aei", "aeim",
+	"aes", "ar", "C", "CC hello", "e asm.bits=32", "e asm.arch=arm", "?$?", "x 16",
+	NULL
+};
+
+static const char *iterators[] = {
+	"@ 0", "@ 0x10", "@ $$+1", "@ foo", "@!8", "@ 0x10!4", "@a:x86:32", "@b:16",
+	"@f:foo", "@@ foo*", "@@ *", "@@=0 1 2", "@@s:0 0x40 8", "@@i", "@@f", "@@b",
+	NULL
+};
+
+static const char *greps[] = {
+	"~foo", "~!foo", "~?", "~[0]", "~[1-2]", "~:0", "~:-1", "~{}", "~{", "~&a,b",
+	"~foo[0]:0", "~$", "~^0x", "~.", "~#", "~+foo",
+	NULL
+};
+
+static const char *wrappers[] = {
+	"?v `%s`", "s `%s`", "?e `%s`", "px `%s`", "?e $(%s)", "$x=%s", "%s; %s", "%s|",
+	NULL
+};
+
+static void prelude(RCore *r) {
+	int i;
+	// deterministic x86 code so that analysis, flags and @@ have something to chew on
+	static const ut8 code[] = {
+		0x55, 0x48, 0x89, 0xe5, 0x48, 0x83, 0xec, 0x10, 0x89, 0x7d, 0xfc, 0x83, 0x7d,
+		0xfc, 0x00, 0x74, 0x07, 0xb8, 0x01, 0x00, 0x00, 0x00, 0xeb, 0x05, 0xb8, 0x00,
+		0x00, 0x00, 0x00, 0xc9, 0xc3
+	};
+	for (i = 0; i < BUFSZ; i++) {
+		pristine[i] = (i < (int)sizeof (code))? code[i]: (ut8)(i * 7);
+	}
+	memcpy (pristine + 0x100, "hello world\0", 12);
+	r_core_cmdf (r, "o malloc://%d", BUFSZ);
+	r_io_write_at (r->io, 0, pristine, BUFSZ);
+	r_core_cmd0 (r, "e cfg.sandbox=true");
+	r_core_cmd0 (r, "e scr.interactive=false");
+	r_core_cmd0 (r, "e scr.color=0");
+	r_core_cmd0 (r, "e asm.arch=x86");
+	r_core_cmd0 (r, "e asm.bits=64");
+	r_core_cmd0 (r, "f foo @ 0x10");
+	r_core_cmd0 (r, "f bar @ 0x100");
+	r_core_cmd0 (r, "af @ 0");
+}
+
+static void load_vocab(const char *path) {
+	char line[1024];
+	int i;
+	FILE *fd = fopen (path, "r");
+	if (fd) {
+		while (fgets (line, sizeof (line), fd)) {
+			r_str_trim_tail (line);
+			if (*line) {
+				vocab.push_back (line);
+			}
+		}
+		fclose (fd);
+	}
+	if (vocab.empty ()) {
+		for (i = 0; builtin_vocab[i]; i++) {
+			vocab.push_back (builtin_vocab[i]);
+		}
+	}
+}
+
+extern "C" int LLVMFuzzerInitialize(int *argc, char ***argv) {
+	const char *path = getenv ("R2_CMD_FUZZ_VOCAB");
+	if (path) {
+		load_vocab (path);
+	} else {
+		char *dir = r_file_dirname ((*argv)[0]);
+		char *file = r_str_newf ("%s/cmd_fuzz.cmds", dir);
+		load_vocab (file);
+		free (file);
+		free (dir);
+	}
+	r_sandbox_enable (true);
+	return 0;
+}
+
+static size_t count(const char **arr) {
+	size_t n = 0;
+	while (arr[n]) {
+		n++;
+	}
+	return n;
+}
+
+static std::vector<std::string> split_stmts(const uint8_t *Data, size_t Size) {
+	std::vector<std::string> stmts;
+	std::string cur;
+	size_t i;
+	for (i = 0; i < Size; i++) {
+		if (Data[i] == '\n') {
+			stmts.push_back (cur);
+			cur.clear ();
+		} else if (Data[i]) {
+			cur += (char)Data[i];
+		}
+	}
+	if (!cur.empty ()) {
+		stmts.push_back (cur);
+	}
+	return stmts;
+}
+
+static std::string mutate_stmt(std::string s, size_t MaxSize) {
+	size_t max = R_MIN (MaxSize, 256);
+	if (s.size () > max) {
+		s.resize (max);
+	}
+	std::vector<uint8_t> buf (s.begin (), s.end ());
+	buf.resize (max);
+	size_t n = LLVMFuzzerMutate (buf.data (), s.size (), max);
+	return std::string (buf.begin (), buf.begin () + n);
+}
+
+extern "C" size_t LLVMFuzzerCustomMutator(uint8_t *Data, size_t Size, size_t MaxSize, unsigned int Seed) {
+	std::minstd_rand rng (Seed);
+	std::vector<std::string> stmts = split_stmts (Data, Size);
+	int rounds = 1 + rng () % 4;
+	while (rounds--) {
+		size_t pos = stmts.empty ()? 0: rng () % stmts.size ();
+		const std::string &word = vocab[rng () % vocab.size ()];
+		char *s;
+		switch (rng () % 9) {
+		case 0: // insert a known statement
+			if (stmts.size () < MAX_STMTS) {
+				stmts.insert (stmts.begin () + pos, word);
+			}
+			break;
+		case 1: // replace a statement
+			if (!stmts.empty ()) {
+				stmts[pos] = word;
+			}
+			break;
+		case 2: // drop a statement
+			if (!stmts.empty ()) {
+				stmts.erase (stmts.begin () + pos);
+			}
+			break;
+		case 3: // swap two statements
+			if (stmts.size () > 1) {
+				std::swap (stmts[pos], stmts[rng () % stmts.size ()]);
+			}
+			break;
+		case 4: // temporal seek or foreach
+			if (!stmts.empty ()) {
+				stmts[pos] += " ";
+				stmts[pos] += iterators[rng () % count (iterators)];
+			}
+			break;
+		case 5: // internal grep
+			if (!stmts.empty ()) {
+				stmts[pos] += greps[rng () % count (greps)];
+			}
+			break;
+		case 6: // nest a statement in backticks, $() or a sequence
+			s = r_str_newf (wrappers[rng () % count (wrappers)], word.c_str (),
+				stmts.empty ()? "": stmts[pos].c_str ());
+			if (stmts.empty ()) {
+				stmts.push_back (s);
+			} else {
+				stmts[pos] = s;
+			}
+			free (s);
+			break;
+		case 7: // join two statements in a single line
+			if (stmts.size () > 1 && pos + 1 < stmts.size ()) {
+				stmts[pos] += ";";
+				stmts[pos] += stmts[pos + 1];
+				stmts.erase (stmts.begin () + pos + 1);
+			}
+			break;
+		default: // byte level mutation of a single statement
+			if (stmts.empty ()) {
+				stmts.push_back (word);
+			}
+			stmts[pos] = mutate_stmt (stmts[pos], MaxSize);
+			break;
+		}
+	}
+	std::string out;
+	for (const auto &stmt : stmts) {
+		out += stmt;
+		out += '\n';
+	}
+	if (out.size () > MaxSize) {
+		out.resize (MaxSize);
+	}
+	memcpy (Data, out.data (), out.size ());
+	return out.size ();
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *Data, size_t Size) {
+	std::vector<std::string> stmts = split_stmts (Data, Size);
+	RCore *core = r_core_new ();
+	size_t i;
+
+	prelude (core);
+	for (i = 0; i < stmts.size () && i < MAX_STMTS; i++) {
+		r_core_cmd0 (core, stmts[i].c_str ());
+	}
+	r_cons_reset ();
+	r_core_free (core);
+	return 0;
+}
@@ -0,0 +1,395 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <inttypes.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <linux/seccomp.h>
+#include <r_core.h>
+
+// ESIL emulator fuzz target.
+//
+// Input layout:
+//   [0]      architecture selector (index into archs[])
+//   [1..16]  instruction bytes
+//   [17..]   optional initial register values, 8 bytes each (x86-64 only)
+//
+// The instruction is stepped with `aes` in the ESIL instance of a single,
+// persistent RCore. For x86-64 the same instruction is executed natively in
+// a seccomp-strict child process which is reused across runs, and the general
+// purpose registers of both are compared. Every mismatch is written as a
+// ready-to-commit (BROKEN) db/esil test to $R2_ESIL_FUZZ_OUT (defaults to
+// ./esil_mismatches). Set R2_ESIL_FUZZ_FLAGS=1 to compare cf/zf/sf/of too.
+
+#define CODESZ 16
+#define NREGS 16
+#define CHILD_TIMEOUT 200
+
+typedef struct {
+	const char *arch;
+	int bits;
+} EsilArch;
+
+static const EsilArch archs[] = {
+	{ "x86", 64 }, { "x86", 32 }, { "arm", 16 }, { "arm", 32 }, { "arm", 64 },
+	{ "mips", 32 }, { "6502", 8 }, { "8051", 8 }, { "sh", 32 }, { "xtensa", 32 },
+};
+
+// x86-64 registers in encoding order, rsp (4) is never touched
+static const char *x64_regs[NREGS] = {
+	"rax", "rcx", "rdx", "rbx", NULL, "rbp", "rsi", "rdi",
+	"r8", "r9", "r10", "r11", "r12", "r13", "r14", "r15"
+};
+
+static const ut64 interesting[] = {
+	0, 1, 0xffffffffffffffffULL, 0x7fffffff, 0x80000000, 0xffffffff,
+	0x100000000ULL, 0x7fffffffffffffffULL, 0x8000000000000000ULL,
+	0x1234567890abcdefULL, 0xdeadbeef, 0x41, 0x8000, 0xff, 0x1f, 63
+};
+
+// instruction types which can be run natively without touching memory or control flow
+static const char *native_types[] = {
+	"mov", "cmov", "add", "sub", "and", "or", "xor", "not", "shl", "shr", "sar",
+	"ror", "rol", "cmp", "acmp", "mul", "xchg", "nop", "lea", NULL
+};
+
+typedef struct {
+	ut8 code[CODESZ];
+	int len;
+	ut64 regs[NREGS];
+} NativeRequest;
+
+typedef struct {
+	ut64 regs[NREGS];
+	ut64 flags;
+} NativeResult;
+
+static RCore *core = NULL;
+static int cur_arch = -1;
+static bool cmp_flags = false;
+static const char *outdir = "esil_mismatches";
+static pid_t child = -1;
+static int to_child = -1;
+static int from_child = -1;
+
+static size_t emit_stub(ut8 *p, const NativeRequest *req, NativeResult *res) {
+	ut8 *s = p;
+	ut64 out = (ut64)(size_t)res;
+	int i;
+	// save callee saved registers
+	*p++ = 0x53; *p++ = 0x55;
+	*p++ = 0x41; *p++ = 0x54; *p++ = 0x41; *p++ = 0x55;
+	*p++ = 0x41; *p++ = 0x56; *p++ = 0x41; *p++ = 0x57;
+	// push 0x202; popfq
+	*p++ = 0x68; *p++ = 0x02; *p++ = 0x02; *p++ = 0x00; *p++ = 0x00;
+	*p++ = 0x9d;
+	// movabs reg, imm64
+	for (i = 0; i < NREGS; i++) {
+		if (i == 4) {
+			continue;
+		}
+		*p++ = 0x48 | (i >= 8);
+		*p++ = 0xb8 + (i & 7);
+		memcpy (p, &req->regs[i], 8);
+		p += 8;
+	}
+	memcpy (p, req->code, req->len);
+	p += req->len;
+	// push rax; pushfq; movabs rax, out
+	*p++ = 0x50; *p++ = 0x9c;
+	*p++ = 0x48; *p++ = 0xb8;
+	memcpy (p, &out, 8);
+	p += 8;
+	// pop qword [rax + flags]; pop qword [rax]
+	*p++ = 0x8f; *p++ = 0x80;
+	*p++ = NREGS * 8; *p++ = 0; *p++ = 0; *p++ = 0;
+	*p++ = 0x8f; *p++ = 0x00;
+	// mov [rax + 8 * i], reg
+	for (i = 1; i < NREGS; i++) {
+		if (i == 4) {
+			continue;
+		}
+		*p++ = 0x48 | ((i >= 8) << 2);
+		*p++ = 0x89;
+		*p++ = 0x40 | ((i & 7) << 3);
+		*p++ = i * 8;
+	}
+	// cld; restore callee saved registers; ret
+	*p++ = 0xfc;
+	*p++ = 0x41; *p++ = 0x5f; *p++ = 0x41; *p++ = 0x5e;
+	*p++ = 0x41; *p++ = 0x5d; *p++ = 0x41; *p++ = 0x5c;
+	*p++ = 0x5d; *p++ = 0x5b;
+	*p++ = 0xc3;
+	return p - s;
+}
+
+static void child_loop(int rfd, int wfd) {
+	NativeRequest req;
+	ut8 *page = (ut8 *)mmap (NULL, 4096, PROT_READ | PROT_WRITE | PROT_EXEC,
+		MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	NativeResult *res = (NativeResult *)(page + 2048);
+	if (page == MAP_FAILED) {
+		syscall (SYS_exit, 1);
+	}
+	// from now on only read, write and exit are allowed
+	if (prctl (PR_SET_SECCOMP, SECCOMP_MODE_STRICT) != 0) {
+		syscall (SYS_exit, 1);
+	}
+	for (;;) {
+		if (read (rfd, &req, sizeof (req)) != sizeof (req)) {
+			syscall (SYS_exit, 0);
+		}
+		emit_stub (page, &req, res);
+		((void (*)(void))page) ();
+		if (write (wfd, res, sizeof (*res)) != sizeof (*res)) {
+			syscall (SYS_exit, 0);
+		}
+	}
+}
+
+static void child_kill(void) {
+	if (child != -1) {
+		kill (child, SIGKILL);
+		waitpid (child, NULL, 0);
+		close (to_child);
+		close (from_child);
+		child = -1;
+	}
+}
+
+static bool child_spawn(void) {
+	int in[2], out[2];
+	if (pipe (in) || pipe (out)) {
+		return false;
+	}
+	child = fork ();
+	if (child == -1) {
+		return false;
+	}
+	if (!child) {
+		close (in[1]);
+		close (out[0]);
+		child_loop (in[0], out[1]);
+	}
+	close (in[0]);
+	close (out[1]);
+	to_child = in[1];
+	from_child = out[0];
+	return true;
+}
+
+static bool native_run(const NativeRequest *req, NativeResult *res) {
+	struct pollfd pfd;
+	if (child == -1 && !child_spawn ()) {
+		return false;
+	}
+	if (write (to_child, req, sizeof (*req)) != sizeof (*req)) {
+		child_kill ();
+		return false;
+	}
+	pfd.fd = from_child;
+	pfd.events = POLLIN;
+	if (poll (&pfd, 1, CHILD_TIMEOUT) != 1 || read (from_child, res, sizeof (*res)) != sizeof (*res)) {
+		// faulting or privileged instruction, respawn on next run
+		child_kill ();
+		return false;
+	}
+	return true;
+}
+
+static char *op_field(const char *field) {
+	char *s = r_core_cmd_str (core, field);
+	if (s) {
+		r_str_trim_tail (s);
+	}
+	return s;
+}
+
+// ESIL starts with rsp=0 while the child runs on its real stack, and the
+// stub itself needs rsp for push/pop/ret, so any use of it is skipped
+static bool uses_stack_pointer(const char *disasm) {
+	static const char *names[] = { "rsp", "esp", "sp", "spl", NULL };
+	const char *p = disasm;
+	int i;
+	while (*p) {
+		size_t len = 0;
+		while (p[len] && isalnum ((ut8)p[len])) {
+			len++;
+		}
+		for (i = 0; len && names[i]; i++) {
+			if (strlen (names[i]) == len && !strncmp (p, names[i], len)) {
+				return true;
+			}
+		}
+		p += len? len: 1;
+	}
+	return false;
+}
+
+static bool is_native(const char *type, const char *disasm) {
+	int i;
+	if (strchr (disasm, '[') && (strncmp (disasm, "lea ", 4) || strstr (disasm, "rip"))) {
+		return false;
+	}
+	if (uses_stack_pointer (disasm)) {
+		return false;
+	}
+	for (i = 0; native_types[i]; i++) {
+		if (!strcmp (type, native_types[i])) {
+			return true;
+		}
+	}
+	return false;
+}
+
+static void emit_test(const NativeRequest *req, const char *disasm, const NativeResult *res, const char **bad, int nbad) {
+	char *hex = r_hex_bin2strdup (req->code, req->len);
+	char *path = r_str_newf ("%s/x86-64_%s", outdir, hex);
+	FILE *fd = fopen (path, "w");
+	int i, j;
+	if (fd) {
+		fprintf (fd, "NAME=esil x86-64 %s (%s)\n", disasm, hex);
+		fprintf (fd, "FILE=-\nBROKEN=1\nCMDS=<<EXPECT\n");
+		fprintf (fd, "e asm.arch=x86\ne asm.bits=64\nwx %s\naei\n", hex);
+		for (i = 0; i < NREGS; i++) {
+			if (x64_regs[i]) {
+				fprintf (fd, "aer %s=0x%" PRIx64 "\n", x64_regs[i], req->regs[i]);
+			}
+		}
+		fprintf (fd, "aes\n");
+		for (j = 0; j < nbad; j++) {
+			fprintf (fd, "aer %s\n", bad[j]);
+		}
+		fprintf (fd, "EXPECT=<<RUN\n");
+		for (j = 0; j < nbad; j++) {
+			for (i = 0; i < NREGS; i++) {
+				if (x64_regs[i] && !strcmp (bad[j], x64_regs[i])) {
+					fprintf (fd, "0x%08" PRIx64 "\n", res->regs[i]);
+				}
+			}
+			if (!strcmp (bad[j], "cf")) {
+				fprintf (fd, "0x%08x\n", (int)(res->flags & 1));
+			} else if (!strcmp (bad[j], "zf")) {
+				fprintf (fd, "0x%08x\n", (int)((res->flags >> 6) & 1));
+			} else if (!strcmp (bad[j], "sf")) {
+				fprintf (fd, "0x%08x\n", (int)((res->flags >> 7) & 1));
+			} else if (!strcmp (bad[j], "of")) {
+				fprintf (fd, "0x%08x\n", (int)((res->flags >> 11) & 1));
+			}
+		}
+		fprintf (fd, "RUN\n");
+		fclose (fd);
+	}
+	free (path);
+	free (hex);
+}
+
+static void differential(const NativeRequest *base) {
+	static const struct { const char *name; int bit; } flags[] = {
+		{ "cf", 0 }, { "zf", 6 }, { "sf", 7 }, { "of", 11 }
+	};
+	NativeRequest req = *base;
+	NativeResult res;
+	const char *bad[NREGS + 4];
+	int i, nbad = 0;
+	char *type = op_field ("ao 1~^type[1]");
+	char *size = op_field ("ao 1~^size[1]");
+	char *disasm = op_field ("pi 1");
+	if (!type || !size || !disasm || !is_native (type, disasm)) {
+		goto beach;
+	}
+	req.len = atoi (size);
+	if (req.len < 1 || req.len > CODESZ) {
+		goto beach;
+	}
+	for (i = 0; i < NREGS; i++) {
+		if (x64_regs[i]) {
+			r_reg_setv (core->anal->reg, x64_regs[i], req.regs[i]);
+		}
+	}
+	r_core_cmd0 (core, "aes");
+	if (!native_run (&req, &res)) {
+		goto beach;
+	}
+	for (i = 0; i < NREGS; i++) {
+		if (x64_regs[i] && r_reg_getv (core->anal->reg, x64_regs[i]) != res.regs[i]) {
+			bad[nbad++] = x64_regs[i];
+		}
+	}
+	if (cmp_flags) {
+		for (i = 0; i < 4; i++) {
+			if (r_reg_getv (core->anal->reg, flags[i].name) != ((res.flags >> flags[i].bit) & 1)) {
+				bad[nbad++] = flags[i].name;
+			}
+		}
+	}
+	if (nbad > 0) {
+		emit_test (&req, disasm, &res, bad, nbad);
+	}
+beach:
+	free (type);
+	free (size);
+	free (disasm);
+}
+
+extern "C" int LLVMFuzzerInitialize(int *argc, char ***argv) {
+	const char *env = getenv ("R2_ESIL_FUZZ_OUT");
+	if (env) {
+		outdir = env;
+	}
+	cmp_flags = getenv ("R2_ESIL_FUZZ_FLAGS") != NULL;
+	r_sys_mkdirp (outdir);
+	// a dead child must not take the fuzzer down with it
+	signal (SIGPIPE, SIG_IGN);
+	core = r_core_new ();
+	r_core_cmd0 (core, "e scr.interactive=false");
+	r_core_cmd0 (core, "e io.va=true");
+	r_core_cmdf (core, "o malloc://%d", CODESZ * 2);
+	r_core_cmd0 (core, "aei");
+	r_core_cmd0 (core, "aeim");
+	return 0;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *Data, size_t Size) {
+	NativeRequest req = {0};
+	size_t i;
+	int arch;
+
+	if (Size < 2) {
+		return 0;
+	}
+	arch = Data[0] % (sizeof (archs) / sizeof (archs[0]));
+	req.len = R_MIN (Size - 1, CODESZ);
+	memcpy (req.code, Data + 1, req.len);
+	for (i = 0; i < NREGS; i++) {
+		size_t off = 1 + CODESZ + i * 8;
+		if (off + 8 <= Size) {
+			memcpy (&req.regs[i], Data + off, 8);
+		} else {
+			req.regs[i] = interesting[i % (sizeof (interesting) / sizeof (interesting[0]))];
+		}
+	}
+
+	if (arch != cur_arch) {
+		r_core_cmdf (core, "e asm.arch=%s", archs[arch].arch);
+		r_core_cmdf (core, "e asm.bits=%d", archs[arch].bits);
+		r_core_cmd0 (core, "aei");
+		cur_arch = arch;
+	}
+	r_io_write_at (core->io, 0, req.code, CODESZ);
+	r_core_cmd0 (core, "s 0");
+	r_core_cmd0 (core, "ar0");
+	if (!strcmp (archs[arch].arch, "x86") && archs[arch].bits == 64) {
+		differential (&req);
+	} else {
+		r_core_cmd0 (core, "aes");
+	}
+	r_cons_reset ();
+	return 0;
+}
@@ -0,0 +1,102 @@
+#include <stdio.h>
+#include <time.h>
+#include <r_core.h>
+
+// Slow input hunter for the RBin parsers.
+//
+// Same harness as ia_fuzz, but the time spent loading the buffer and running
+// `ia` is fed back to the fuzzer: every power of two of elapsed milliseconds
+// sets its own libFuzzer extra counter, so inputs reaching a slower bucket
+// are kept as new coverage. Run it on its own corpus directory.
+//
+// Inputs taking more than $R2_SLOW_MS (500 by default) are saved to
+// $R2_SLOW_OUT (./slow_inputs) together with a BROKEN db/formats performance
+// test, ready to be copied to bins/fuzzed and appended to new/db/formats.
+
+static int slow_ms = 500;
+static const char *outdir = "slow_inputs";
+
+static double now_ms(void) {
+	struct timespec ts;
+	clock_gettime (CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+#define NBUCKETS 14
+
+// libFuzzer treats every non zero byte in this section as a feature of the
+// run, the same way as the counters of compiler inserted edges
+__attribute__((used, section("__libfuzzer_extra_counters")))
+static uint8_t slow_counters[NBUCKETS];
+
+static void feedback(double ms) {
+	ut64 ims = (ut64)ms;
+	int bucket = 0;
+	// 0 ms, 1 ms, 2-3 ms, 4-7 ms, ...
+	while (bucket < NBUCKETS - 1 && ims) {
+		ims >>= 1;
+		bucket++;
+	}
+	slow_counters[bucket] = 1;
+}
+
+static void save_slow(const uint8_t *Data, size_t Size, double ms) {
+	RHash *h = r_hash_new (true, R_HASH_MD5);
+	char *name, *path;
+	FILE *fd;
+	r_hash_do_md5 (h, Data, Size);
+	name = r_hex_bin2strdup (h->digest, R_HASH_SIZE_MD5);
+	path = r_str_newf ("%s/slow-%s", outdir, name);
+	r_file_dump (path, Data, Size, false);
+	free (path);
+	path = r_str_newf ("%s/slow-%s.test", outdir, name);
+	fd = fopen (path, "w");
+	if (fd) {
+		fprintf (fd, "NAME=slow ia %s (%d ms)\n", name, (int)ms);
+		fprintf (fd, "FILE=../bins/fuzzed/slow-%s\n", name);
+		fprintf (fd, "BROKEN=1\n");
+		fprintf (fd, "TIMEOUT=%d\n", R_MAX (1, (slow_ms + 999) / 1000));
+		fprintf (fd, "CMDS=ia\n");
+		fprintf (fd, "RUN\n");
+		fclose (fd);
+	}
+	free (path);
+	free (name);
+	r_hash_free (h);
+}
+
+extern "C" int LLVMFuzzerInitialize(int *argc, char ***argv) {
+	const char *env = getenv ("R2_SLOW_MS");
+	if (env) {
+		slow_ms = atoi (env);
+	}
+	env = getenv ("R2_SLOW_OUT");
+	if (env) {
+		outdir = env;
+	}
+	r_sys_mkdirp (outdir);
+	return 0;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *Data, size_t Size) {
+	RCore *r;
+	double ms;
+
+	r = r_core_new ();
+
+	r_core_cmdf (r, "o malloc://%d", Size);
+	r_io_write_at (r->io, 0, Data, Size);
+
+	ms = now_ms ();
+	r_core_cmd0 (r, "oba 0");
+	r_core_cmd0 (r, "ia");
+	ms = now_ms () - ms;
+
+	r_core_free (r);
+
+	feedback (ms);
+	if (ms > slow_ms) {
+		save_slow (Data, Size, ms);
+	}
+	return 0;
+}
@@ -250,6 +250,13 @@ class NewRegressions {
           test.spawnArgs = args;
           const child = spawn(r2bin, args);
           test.birth = new Date();
+          // performance tests: kill r2 if it does not finish in TIMEOUT seconds
+          const timer = test.timeout
+            ? setTimeout(() => {
+              test.timedOut = true;
+              child.kill('SIGKILL');
+            }, test.timeout * 1000)
+            : null;
           child.stdout.on('data', data => {
             res += data.toString();
           });
@@ -258,6 +265,9 @@ class NewRegressions {
           });
           child.on('close', data => {
             test.death = new Date();
+            if (timer !== null) {
+              clearTimeout(timer);
+            }
             try {
               if (test.tmpScript) {
                 // TODO use yield
@@ -502,6 +512,9 @@ class NewRegressions {
         case 'FILE':
           test.file = v;
           break;
+        case 'TIMEOUT':
+          test.timeout = +v;
+          break;
         default:
           throw new Error('Invalid database, key =(', k, ')');
       }
@@ -585,7 +598,7 @@ class NewRegressions {
       test.stdoutFail = false;
     }
     test.stderrFail = test.expectErr !== undefined ? test.expectErr !== test.stderr : false;
-    test.passes = !test.stdoutFail && !test.stderrFail;
+    test.passes = !test.stdoutFail && !test.stderrFail && !test.timedOut;
     const status = (test.passes)
     ? (test.broken ? colors.yellow('[FX]') : colors.green('[OK]'))
     : (test.broken ? colors.blue('[BR]') : colors.red('[XX]'));
@@ -634,6 +647,9 @@ class NewRegressions {
       if (test.cmdScript !== undefined) {
         console.log(test.cmdScript);
       }
+      if (test.timedOut) {
+        console.log(colors.red('Timeout: killed after ' + test.timeout + 's'));
+      }
 
       let showHeaders = test.stderrFail;
       if (test.stdoutFail) {
@@ -0,0 +1,129 @@
+#include <r_util.h>
+#include "minbench.h"
+
+// Allocation and teardown of n small analysis-like objects: one malloc and
+// one free per object against bump allocation from an arena released at
+// once. Every case times both the allocations and the teardown.
+// r_mem_pool is not timed, its alloc hands out overlapping blocks (see
+// test_pool.c), the arena below is the reference it should reach.
+
+#define ARENA_CHUNK 0x10000
+
+typedef struct {
+	void **ptrs;
+	int *classes;
+} AllocBench;
+
+#define CLASS_SIZE(c) (16 << (c))
+
+static void *setup_ptrs(size_t n) {
+	AllocBench *b = R_NEW0 (AllocBench);
+	size_t i;
+	b->ptrs = calloc (n, sizeof (void *));
+	b->classes = calloc (n, sizeof (int));
+	// blocks, ops and xrefs range from a few words to a few hundred bytes
+	for (i = 0; i < n; i++) {
+		b->classes[i] = mb_rand () % 5;
+	}
+	return b;
+}
+
+static void teardown_ptrs(void *ctx) {
+	AllocBench *b = ctx;
+	free (b->ptrs);
+	free (b->classes);
+	free (b);
+}
+
+static void run_malloc_64(void *ctx, size_t n) {
+	AllocBench *b = ctx;
+	size_t i;
+	for (i = 0; i < n; i++) {
+		b->ptrs[i] = malloc (64);
+		memset (b->ptrs[i], 0, 64);
+	}
+	for (i = 0; i < n; i++) {
+		free (b->ptrs[i]);
+	}
+}
+
+static void run_malloc_mixed(void *ctx, size_t n) {
+	AllocBench *b = ctx;
+	size_t i;
+	for (i = 0; i < n; i++) {
+		b->ptrs[i] = malloc (CLASS_SIZE (b->classes[i]));
+		memset (b->ptrs[i], 0, CLASS_SIZE (b->classes[i]));
+	}
+	for (i = 0; i < n; i++) {
+		free (b->ptrs[i]);
+	}
+}
+
+typedef struct {
+	ut8 **chunks;
+	int nchunks;
+	size_t used;
+} Arena;
+
+// sizes are multiples of 16, so every block stays 16 byte aligned
+static void *arena_alloc(Arena *a, size_t size) {
+	void *p;
+	if (!a->nchunks || a->used + size > ARENA_CHUNK) {
+		a->chunks = realloc (a->chunks, (a->nchunks + 1) * sizeof (ut8 *));
+		a->chunks[a->nchunks++] = malloc (ARENA_CHUNK);
+		a->used = 0;
+	}
+	p = a->chunks[a->nchunks - 1] + a->used;
+	a->used += size;
+	return p;
+}
+
+static void arena_fini(Arena *a) {
+	int i;
+	for (i = 0; i < a->nchunks; i++) {
+		free (a->chunks[i]);
+	}
+	free (a->chunks);
+}
+
+static void run_arena_64(void *ctx, size_t n) {
+	Arena a = {0};
+	size_t i;
+	for (i = 0; i < n; i++) {
+		memset (arena_alloc (&a, 64), 0, 64);
+	}
+	arena_fini (&a);
+}
+
+static void run_arena_mixed(void *ctx, size_t n) {
+	AllocBench *b = ctx;
+	Arena a = {0};
+	size_t i;
+	for (i = 0; i < n; i++) {
+		int c = b->classes[i];
+		memset (arena_alloc (&a, CLASS_SIZE (c)), 0, CLASS_SIZE (c));
+	}
+	arena_fini (&a);
+}
+
+// the per-node allocations done by every analysis list
+static void run_list_append_free(void *ctx, size_t n) {
+	RList *list = r_list_newf (free);
+	size_t i;
+	for (i = 0; i < n; i++) {
+		r_list_append (list, calloc (1, 64));
+	}
+	r_list_free (list);
+}
+
+int main(int argc, char **argv) {
+	if (!mb_init (argc, argv)) {
+		return 1;
+	}
+	mb_run ("malloc_free_64", setup_ptrs, run_malloc_64, teardown_ptrs, 1000000);
+	mb_run ("malloc_free_mixed", setup_ptrs, run_malloc_mixed, teardown_ptrs, 1000000);
+	mb_run ("arena_64", NULL, run_arena_64, NULL, 1000000);
+	mb_run ("arena_mixed", setup_ptrs, run_arena_mixed, teardown_ptrs, 1000000);
+	mb_run ("rlist_append_free", NULL, run_list_append_free, NULL, 1000000);
+	return mb_report ();
+}
@@ -0,0 +1,73 @@
+#include <r_util.h>
+#include "minbench.h"
+
+// r_base64 encode/decode throughput over n bytes of data (ns/op is per
+// input byte), plus short line by line decoding as r2r does for CMDS64
+// and EXPECT64 entries
+
+#define LINE 76
+
+typedef struct {
+	ut8 *bin;
+	char *enc;
+	int enclen;
+} Base64Bench;
+
+static void *setup_base64(size_t n) {
+	Base64Bench *b = R_NEW0 (Base64Bench);
+	size_t i;
+	b->bin = malloc (n + 3);
+	for (i = 0; i < n; i++) {
+		b->bin[i] = mb_rand ();
+	}
+	b->enc = malloc ((n + 2) / 3 * 4 + 1);
+	b->enclen = r_base64_encode (b->enc, b->bin, n);
+	return b;
+}
+
+static void teardown_base64(void *ctx) {
+	Base64Bench *b = ctx;
+	free (b->bin);
+	free (b->enc);
+	free (b);
+}
+
+static void run_encode(void *ctx, size_t n) {
+	Base64Bench *b = ctx;
+	mb_sink = r_base64_encode (b->enc, b->bin, n);
+}
+
+static void run_decode(void *ctx, size_t n) {
+	Base64Bench *b = ctx;
+	mb_sink = r_base64_decode (b->bin, b->enc, b->enclen);
+}
+
+static void run_decode_dyn(void *ctx, size_t n) {
+	Base64Bench *b = ctx;
+	ut8 *dec = r_base64_decode_dyn (b->enc, b->enclen);
+	mb_sink = dec[0];
+	free (dec);
+}
+
+static void run_decode_lines(void *ctx, size_t n) {
+	Base64Bench *b = ctx;
+	size_t out = 0;
+	int pos;
+	for (pos = 0; pos < b->enclen; pos += LINE) {
+		ut8 *dec = r_base64_decode_dyn (b->enc + pos, R_MIN (LINE, b->enclen - pos));
+		out += dec[0];
+		free (dec);
+	}
+	mb_sink = out;
+}
+
+int main(int argc, char **argv) {
+	if (!mb_init (argc, argv)) {
+		return 1;
+	}
+	mb_run ("rbase64_encode", setup_base64, run_encode, teardown_base64, MB_MAX);
+	mb_run ("rbase64_decode", setup_base64, run_decode, teardown_base64, MB_MAX);
+	mb_run ("rbase64_decode_dyn", setup_base64, run_decode_dyn, teardown_base64, MB_MAX);
+	mb_run ("rbase64_decode_lines_76", setup_base64, run_decode_lines, teardown_base64, MB_MAX);
+	return mb_report ();
+}
@@ -0,0 +1,101 @@
+#include <r_util.h>
+#include "minbench.h"
+
+// RBitmap as a visited set: n bits, one per byte of a large binary.
+// Counting and scanning go bit by bit through r_bitmap_test, which is
+// what callers have to do today.
+
+static void *setup_empty(size_t n) {
+	return r_bitmap_new (n);
+}
+
+static void *setup_half(size_t n) {
+	RBitmap *b = r_bitmap_new (n);
+	size_t i;
+	for (i = 0; i < n; i++) {
+		if (mb_rand () & 1) {
+			r_bitmap_set (b, i);
+		}
+	}
+	return b;
+}
+
+static void *setup_sparse(size_t n) {
+	RBitmap *b = r_bitmap_new (n);
+	size_t i;
+	for (i = 0; i < n / 1000 + 1; i++) {
+		r_bitmap_set (b, mb_rand () % n);
+	}
+	return b;
+}
+
+static void teardown_bitmap(void *b) {
+	r_bitmap_free (b);
+}
+
+static void run_set_seq(void *b, size_t n) {
+	size_t i;
+	for (i = 0; i < n; i++) {
+		r_bitmap_set (b, i);
+	}
+}
+
+static void run_set_random(void *b, size_t n) {
+	size_t i;
+	for (i = 0; i < n; i++) {
+		r_bitmap_set (b, mb_rand () % n);
+	}
+}
+
+static void run_test_random(void *b, size_t n) {
+	size_t i, hits = 0;
+	for (i = 0; i < n; i++) {
+		hits += !!r_bitmap_test (b, mb_rand () % n);
+	}
+	mb_sink = hits;
+}
+
+static void run_popcount(void *b, size_t n) {
+	size_t i, count = 0;
+	for (i = 0; i < n; i++) {
+		count += !!r_bitmap_test (b, i);
+	}
+	mb_sink = count;
+}
+
+// find-next-set over a mostly empty bitmap
+static void run_iterate_sparse(void *b, size_t n) {
+	size_t i, sum = 0;
+	for (i = 0; i < n; i++) {
+		if (r_bitmap_test (b, i)) {
+			sum += i;
+		}
+	}
+	mb_sink = sum;
+}
+
+static void *setup_bytes(size_t n) {
+	return calloc (n, 1);
+}
+
+// the byte per bit alternative, 8 times the memory
+static void run_bytes_set_random(void *a, size_t n) {
+	ut8 *bytes = a;
+	size_t i;
+	for (i = 0; i < n; i++) {
+		bytes[mb_rand () % n] = 1;
+	}
+}
+
+int main(int argc, char **argv) {
+	if (!mb_init (argc, argv)) {
+		return 1;
+	}
+	mb_run ("rbitmap_set_seq", setup_empty, run_set_seq, teardown_bitmap, MB_MAX);
+	mb_run ("rbitmap_set_random", setup_empty, run_set_random, teardown_bitmap, MB_MAX);
+	mb_run ("rbitmap_test_random", setup_half, run_test_random, teardown_bitmap, MB_MAX);
+	mb_run ("rbitmap_popcount", setup_half, run_popcount, teardown_bitmap, MB_MAX);
+	mb_run ("rbitmap_iterate_sparse", setup_sparse, run_iterate_sparse, teardown_bitmap, MB_MAX);
+	mb_run ("bytes_set_random", setup_bytes, run_bytes_set_random, free, MB_MAX);
+	return mb_report ();
+}
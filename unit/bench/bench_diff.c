@@ -0,0 +1,133 @@
+#include <r_diff.h>
+#include "minbench.h"
+
+// r_diff_buffers_distance between two n byte buffers, the second one being
+// the first with about 5% of bytes edited, as for a pair of similar
+// functions. ns/op is per byte; the distance is quadratic so n is capped.
+
+typedef struct {
+	RDiff *diff;
+	ut8 *a;
+	ut8 *b;
+	ut32 la;
+	ut32 lb;
+} DiffBench;
+
+static DiffBench *setup_diff(size_t n, int type) {
+	DiffBench *d = R_NEW0 (DiffBench);
+	size_t i;
+	d->diff = r_diff_new ();
+	d->diff->type = type;
+	d->a = malloc (n);
+	d->b = malloc (n * 2);
+	for (i = 0; i < n; i++) {
+		// code-like: a few frequent opcode bytes
+		d->a[i] = (mb_rand () & 3)? mb_rand () % 16: mb_rand ();
+	}
+	d->la = n;
+	for (i = 0; i < n; i++) {
+		switch (mb_rand () % 60) {
+		case 0:
+			break;
+		case 1:
+			d->b[d->lb++] = mb_rand ();
+			d->b[d->lb++] = d->a[i];
+			break;
+		case 2:
+			d->b[d->lb++] = mb_rand ();
+			break;
+		default:
+			d->b[d->lb++] = d->a[i];
+		}
+	}
+	return d;
+}
+
+static void *setup_original(size_t n) {
+	return setup_diff (n, '\0');
+}
+
+static void *setup_myers(size_t n) {
+	return setup_diff (n, 'm');
+}
+
+static void teardown_diff(void *ctx) {
+	DiffBench *d = ctx;
+	r_diff_free (d->diff);
+	free (d->a);
+	free (d->b);
+	free (d);
+}
+
+static void run_distance(void *ctx, size_t n) {
+	DiffBench *d = ctx;
+	ut32 distance = 0;
+	double similarity;
+	r_diff_buffers_distance (d->diff, d->a, d->la, d->b, d->lb, &distance, &similarity);
+	mb_sink = distance;
+}
+
+// radiff2 -C style matching of 256 byte functions, every one against every
+// other: n is the number of pairs compared, so ns/op is per pair, and
+// enough functions are built for n distinct pairs
+#define FCN_SIZE 256
+
+typedef struct {
+	RDiff *diff;
+	ut8 *fcns;
+	size_t count;
+} PairsBench;
+
+static void *setup_pairs(size_t n) {
+	PairsBench *p = R_NEW0 (PairsBench);
+	size_t i;
+	p->diff = r_diff_new ();
+	p->diff->type = 'm';
+	p->count = 2;
+	while (p->count * (p->count - 1) < n) {
+		p->count++;
+	}
+	p->fcns = malloc (p->count * FCN_SIZE);
+	for (i = 0; i < p->count * FCN_SIZE; i++) {
+		p->fcns[i] = (mb_rand () & 3)? mb_rand () % 16: mb_rand ();
+	}
+	return p;
+}
+
+static void teardown_pairs(void *ctx) {
+	PairsBench *p = ctx;
+	r_diff_free (p->diff);
+	free (p->fcns);
+	free (p);
+}
+
+static void run_pairs(void *ctx, size_t n) {
+	PairsBench *p = ctx;
+	double similarity, best = 0;
+	ut32 distance;
+	size_t i, j, done = 0;
+	for (i = 0; i < p->count && done < n; i++) {
+		for (j = 0; j < p->count && done < n; j++) {
+			if (i == j) {
+				continue;
+			}
+			r_diff_buffers_distance (p->diff, p->fcns + i * FCN_SIZE, FCN_SIZE,
+				p->fcns + j * FCN_SIZE, FCN_SIZE, &distance, &similarity);
+			if (similarity > best) {
+				best = similarity;
+			}
+			done++;
+		}
+	}
+	mb_sink = (size_t)(best * 1000);
+}
+
+int main(int argc, char **argv) {
+	if (!mb_init (argc, argv)) {
+		return 1;
+	}
+	mb_run ("rdiff_distance_original", setup_original, run_distance, teardown_diff, 10000);
+	mb_run ("rdiff_distance_myers", setup_myers, run_distance, teardown_diff, 100000);
+	mb_run ("rdiff_allpairs_256", setup_pairs, run_pairs, teardown_pairs, 10000);
+	return mb_report ();
+}
@@ -0,0 +1,152 @@
+#include <r_hash.h>
+#include "minbench.h"
+
+// RHash throughput over n bytes (ns/op is per byte, 1 / (ns/op) is GB/s).
+// The md5+sha1+sha256 cases compare one pass per algorithm, as rahash2
+// -a md5,sha1,sha256 does today, with a single pass feeding all of them
+// block by block while the block is still in cache.
+
+#define BLOCK 0x10000
+
+#define ALL (R_HASH_MD5 | R_HASH_SHA1 | R_HASH_SHA256)
+
+typedef struct {
+	ut8 *buf;
+	RHash *h;
+} HashBench;
+
+static void *setup_hash(size_t n) {
+	HashBench *b = R_NEW0 (HashBench);
+	size_t i;
+	b->buf = malloc (n);
+	for (i = 0; i < n; i += 8) {
+		ut64 r = mb_rand ();
+		memcpy (b->buf + i, &r, R_MIN (8, n - i));
+	}
+	b->h = r_hash_new (false, ALL | R_HASH_SHA512);
+	return b;
+}
+
+static void teardown_hash(void *ctx) {
+	HashBench *b = ctx;
+	r_hash_free (b->h);
+	free (b->buf);
+	free (b);
+}
+
+typedef ut8 *(*HashDo)(RHash *h, const ut8 *buf, int len);
+
+static void hash_blocks(HashBench *b, ut64 algo, HashDo fn, size_t n) {
+	size_t off;
+	r_hash_do_begin (b->h, algo);
+	for (off = 0; off < n; off += BLOCK) {
+		fn (b->h, b->buf + off, R_MIN (BLOCK, n - off));
+	}
+	r_hash_do_end (b->h, algo);
+	mb_sink = b->h->digest[0];
+}
+
+static void run_md5(void *ctx, size_t n) {
+	hash_blocks (ctx, R_HASH_MD5, r_hash_do_md5, n);
+}
+
+static void run_sha1(void *ctx, size_t n) {
+	hash_blocks (ctx, R_HASH_SHA1, r_hash_do_sha1, n);
+}
+
+static void run_sha256(void *ctx, size_t n) {
+	hash_blocks (ctx, R_HASH_SHA256, r_hash_do_sha256, n);
+}
+
+static void run_sha512(void *ctx, size_t n) {
+	hash_blocks (ctx, R_HASH_SHA512, r_hash_do_sha512, n);
+}
+
+static void run_crc32(void *ctx, size_t n) {
+	mb_sink = r_hash_crc32 (((HashBench *)ctx)->buf, n);
+}
+
+static void run_xxhash(void *ctx, size_t n) {
+	mb_sink = r_hash_xxhash (((HashBench *)ctx)->buf, n);
+}
+
+// rahash2 -B over a sparse file: one md5 per 4 KiB block of zeros
+static void *setup_sparse(size_t n) {
+	HashBench *b = setup_hash (n);
+	memset (b->buf, 0, n);
+	// every block is a separate digest
+	r_hash_free (b->h);
+	b->h = r_hash_new (true, R_HASH_MD5 | R_HASH_SHA256);
+	return b;
+}
+
+static void run_blocks(void *ctx, size_t n) {
+	HashBench *b = ctx;
+	size_t off;
+	for (off = 0; off < n; off += 0x1000) {
+		r_hash_do_md5 (b->h, b->buf + off, R_MIN (0x1000, n - off));
+	}
+	mb_sink = b->h->digest[0];
+}
+
+// tree hash: sha256 per 4 KiB block, then sha256 over each pair of
+// digests up to a single root
+static void run_merkle(void *ctx, size_t n) {
+	HashBench *b = ctx;
+	size_t count = (n + 0xfff) / 0x1000, off, i;
+	ut8 *level = malloc (R_MAX (count, 2) * R_HASH_SIZE_SHA256);
+	for (off = 0, i = 0; off < n; off += 0x1000, i++) {
+		r_hash_do_sha256 (b->h, b->buf + off, R_MIN (0x1000, n - off));
+		memcpy (level + i * R_HASH_SIZE_SHA256, b->h->digest, R_HASH_SIZE_SHA256);
+	}
+	while (count > 1) {
+		for (i = 0; i < count / 2; i++) {
+			r_hash_do_sha256 (b->h, level + i * 2 * R_HASH_SIZE_SHA256, 2 * R_HASH_SIZE_SHA256);
+			memcpy (level + i * R_HASH_SIZE_SHA256, b->h->digest, R_HASH_SIZE_SHA256);
+		}
+		if (count & 1) {
+			memmove (level + i * R_HASH_SIZE_SHA256, level + (count - 1) * R_HASH_SIZE_SHA256, R_HASH_SIZE_SHA256);
+			i++;
+		}
+		count = i;
+	}
+	mb_sink = level[0];
+	free (level);
+}
+
+static void run_three_passes(void *ctx, size_t n) {
+	run_md5 (ctx, n);
+	run_sha1 (ctx, n);
+	run_sha256 (ctx, n);
+}
+
+static void run_single_pass(void *ctx, size_t n) {
+	HashBench *b = ctx;
+	size_t off;
+	r_hash_do_begin (b->h, ALL);
+	for (off = 0; off < n; off += BLOCK) {
+		int len = R_MIN (BLOCK, n - off);
+		r_hash_do_md5 (b->h, b->buf + off, len);
+		r_hash_do_sha1 (b->h, b->buf + off, len);
+		r_hash_do_sha256 (b->h, b->buf + off, len);
+	}
+	r_hash_do_end (b->h, ALL);
+	mb_sink = b->h->digest[0];
+}
+
+int main(int argc, char **argv) {
+	if (!mb_init (argc, argv)) {
+		return 1;
+	}
+	mb_run ("rhash_md5", setup_hash, run_md5, teardown_hash, MB_MAX);
+	mb_run ("rhash_sha1", setup_hash, run_sha1, teardown_hash, MB_MAX);
+	mb_run ("rhash_sha256", setup_hash, run_sha256, teardown_hash, MB_MAX);
+	mb_run ("rhash_sha512", setup_hash, run_sha512, teardown_hash, MB_MAX);
+	mb_run ("rhash_crc32", setup_hash, run_crc32, teardown_hash, MB_MAX);
+	mb_run ("rhash_xxhash", setup_hash, run_xxhash, teardown_hash, MB_MAX);
+	mb_run ("rhash_md5_sha1_sha256_3pass", setup_hash, run_three_passes, teardown_hash, MB_MAX);
+	mb_run ("rhash_md5_sha1_sha256_1pass", setup_hash, run_single_pass, teardown_hash, MB_MAX);
+	mb_run ("rhash_md5_blocks_4k_sparse", setup_sparse, run_blocks, teardown_hash, MB_MAX);
+	mb_run ("rhash_sha256_merkle_4k_sparse", setup_sparse, run_merkle, teardown_hash, MB_MAX);
+	return mb_report ();
+}
@@ -0,0 +1,70 @@
+#include <r_util.h>
+#include "minbench.h"
+
+// r_hex_bin2str / r_hex_str2bin throughput over n bytes of data (ns/op is
+// per byte), as used by p8, pcj and wx on large ranges
+
+typedef struct {
+	ut8 *bin;
+	char *str;
+	char *spaced;
+} HexBench;
+
+static void *setup_hex(size_t n) {
+	HexBench *b = R_NEW0 (HexBench);
+	size_t i;
+	b->bin = malloc (n);
+	for (i = 0; i < n; i++) {
+		b->bin[i] = mb_rand ();
+	}
+	b->str = malloc (n * 2 + 1);
+	r_hex_bin2str (b->bin, n, b->str);
+	// "41 42 43" as written by hand or copied from a hexdump
+	b->spaced = malloc (n * 3 + 1);
+	for (i = 0; i < n; i++) {
+		b->spaced[i * 3] = b->str[i * 2];
+		b->spaced[i * 3 + 1] = b->str[i * 2 + 1];
+		b->spaced[i * 3 + 2] = ' ';
+	}
+	b->spaced[n * 3] = 0;
+	return b;
+}
+
+static void teardown_hex(void *ctx) {
+	HexBench *b = ctx;
+	free (b->bin);
+	free (b->str);
+	free (b->spaced);
+	free (b);
+}
+
+static void run_bin2str(void *ctx, size_t n) {
+	HexBench *b = ctx;
+	mb_sink = r_hex_bin2str (b->bin, n, b->str);
+}
+
+static void run_str2bin(void *ctx, size_t n) {
+	HexBench *b = ctx;
+	mb_sink = r_hex_str2bin (b->str, b->bin);
+}
+
+static void run_str2bin_spaced(void *ctx, size_t n) {
+	HexBench *b = ctx;
+	mb_sink = r_hex_str2bin (b->spaced, b->bin);
+}
+
+static void run_str2bin_len(void *ctx, size_t n) {
+	HexBench *b = ctx;
+	mb_sink = r_hex_str2bin (b->str, NULL);
+}
+
+int main(int argc, char **argv) {
+	if (!mb_init (argc, argv)) {
+		return 1;
+	}
+	mb_run ("rhex_bin2str", setup_hex, run_bin2str, teardown_hex, MB_MAX);
+	mb_run ("rhex_str2bin", setup_hex, run_str2bin, teardown_hex, MB_MAX);
+	mb_run ("rhex_str2bin_spaced", setup_hex, run_str2bin_spaced, teardown_hex, MB_MAX);
+	mb_run ("rhex_str2bin_len", setup_hex, run_str2bin_len, teardown_hex, MB_MAX);
+	return mb_report ();
+}
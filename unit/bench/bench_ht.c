@@ -0,0 +1,197 @@
+#include <r_util.h>
+#include <r_flag.h>
+#include <sdb.h>
+#include "minbench.h"
+
+// keys are formatted in setup so that only the table operations are timed
+typedef struct {
+	SdbHash *ht;
+	RFlag *flags;
+	RList *list;
+	char **keys;
+	char **misses;
+	size_t n;
+} HtBench;
+
+static char **make_keys(size_t n, const char *fmt) {
+	char **keys = calloc (n, sizeof (char *));
+	size_t i;
+	for (i = 0; i < n; i++) {
+		keys[i] = r_str_newf (fmt, (ut64)(0x400000 + i * 16));
+	}
+	return keys;
+}
+
+static void free_keys(char **keys, size_t n) {
+	size_t i;
+	for (i = 0; i < n; i++) {
+		free (keys[i]);
+	}
+	free (keys);
+}
+
+static void *setup_ht_empty(size_t n) {
+	HtBench *b = R_NEW0 (HtBench);
+	b->n = n;
+	b->ht = ht_new (NULL, NULL, NULL);
+	b->keys = make_keys (n, "fcn.%08"PFMT64x);
+	return b;
+}
+
+static void *setup_ht_filled(size_t n) {
+	HtBench *b = setup_ht_empty (n);
+	size_t i;
+	for (i = 0; i < n; i++) {
+		ht_insert (b->ht, b->keys[i], (void *)i);
+	}
+	b->misses = make_keys (n, "sym.%08"PFMT64x);
+	return b;
+}
+
+static void teardown_ht(void *ctx) {
+	HtBench *b = ctx;
+	ht_free (b->ht);
+	free_keys (b->keys, b->n);
+	if (b->misses) {
+		free_keys (b->misses, b->n);
+	}
+	free (b);
+}
+
+static void run_ht_insert(void *ctx, size_t n) {
+	HtBench *b = ctx;
+	size_t i;
+	for (i = 0; i < n; i++) {
+		ht_insert (b->ht, b->keys[i], (void *)i);
+	}
+}
+
+static void run_ht_find_hit(void *ctx, size_t n) {
+	HtBench *b = ctx;
+	size_t i, sum = 0;
+	for (i = 0; i < n; i++) {
+		sum += (size_t)ht_find (b->ht, b->keys[mb_rand () % n], NULL);
+	}
+	mb_sink = sum;
+}
+
+static void run_ht_find_miss(void *ctx, size_t n) {
+	HtBench *b = ctx;
+	size_t i, found = 0;
+	bool f;
+	for (i = 0; i < n; i++) {
+		ht_find (b->ht, b->misses[mb_rand () % n], &f);
+		found += f;
+	}
+	mb_sink = found;
+}
+
+static void run_ht_delete(void *ctx, size_t n) {
+	HtBench *b = ctx;
+	size_t i;
+	for (i = 0; i < n; i++) {
+		ht_delete (b->ht, b->keys[i]);
+	}
+}
+
+static void *setup_flag_empty(size_t n) {
+	HtBench *b = R_NEW0 (HtBench);
+	b->n = n;
+	b->flags = r_flag_new ();
+	b->keys = make_keys (n, "fcn.%08"PFMT64x);
+	return b;
+}
+
+static void *setup_flag_filled(size_t n) {
+	HtBench *b = setup_flag_empty (n);
+	size_t i;
+	for (i = 0; i < n; i++) {
+		r_flag_set (b->flags, b->keys[i], 0x400000 + i * 16, 1);
+	}
+	return b;
+}
+
+static void teardown_flag(void *ctx) {
+	HtBench *b = ctx;
+	r_flag_free (b->flags);
+	free_keys (b->keys, b->n);
+	free (b);
+}
+
+static void run_flag_set(void *ctx, size_t n) {
+	HtBench *b = ctx;
+	size_t i;
+	for (i = 0; i < n; i++) {
+		r_flag_set (b->flags, b->keys[i], 0x400000 + i * 16, 1);
+	}
+}
+
+static void run_flag_get(void *ctx, size_t n) {
+	HtBench *b = ctx;
+	size_t i, sum = 0;
+	for (i = 0; i < n; i++) {
+		sum += (size_t)r_flag_get (b->flags, b->keys[mb_rand () % n]);
+	}
+	mb_sink = sum;
+}
+
+static void run_flag_get_i(void *ctx, size_t n) {
+	HtBench *b = ctx;
+	size_t i, sum = 0;
+	for (i = 0; i < n; i++) {
+		sum += (size_t)r_flag_get_i (b->flags, 0x400000 + (mb_rand () % n) * 16);
+	}
+	mb_sink = sum;
+}
+
+// the linear name lookups the hashtable replaced
+static void *setup_list_filled(size_t n) {
+	HtBench *b = R_NEW0 (HtBench);
+	size_t i;
+	b->n = n;
+	b->list = r_list_new ();
+	b->keys = make_keys (n, "fcn.%08"PFMT64x);
+	for (i = 0; i < n; i++) {
+		r_list_append (b->list, b->keys[i]);
+	}
+	return b;
+}
+
+static void teardown_list(void *ctx) {
+	HtBench *b = ctx;
+	r_list_free (b->list);
+	free_keys (b->keys, b->n);
+	free (b);
+}
+
+static void run_list_find(void *ctx, size_t n) {
+	HtBench *b = ctx;
+	size_t i, found = 0;
+	RListIter *iter;
+	char *key;
+	for (i = 0; i < n; i++) {
+		const char *k = b->keys[mb_rand () % n];
+		r_list_foreach (b->list, iter, key) {
+			if (!strcmp (key, k)) {
+				found++;
+				break;
+			}
+		}
+	}
+	mb_sink = found;
+}
+
+int main(int argc, char **argv) {
+	if (!mb_init (argc, argv)) {
+		return 1;
+	}
+	mb_run ("ht_insert", setup_ht_empty, run_ht_insert, teardown_ht, MB_MAX);
+	mb_run ("ht_find_hit", setup_ht_filled, run_ht_find_hit, teardown_ht, MB_MAX);
+	mb_run ("ht_find_miss", setup_ht_filled, run_ht_find_miss, teardown_ht, MB_MAX);
+	mb_run ("ht_delete", setup_ht_filled, run_ht_delete, teardown_ht, MB_MAX);
+	mb_run ("rflag_set", setup_flag_empty, run_flag_set, teardown_flag, 1000000);
+	mb_run ("rflag_get", setup_flag_filled, run_flag_get, teardown_flag, 1000000);
+	mb_run ("rflag_get_i", setup_flag_filled, run_flag_get_i, teardown_flag, 1000000);
+	mb_run ("rlist_find_str", setup_list_filled, run_list_find, teardown_list, 10000);
+	return mb_report ();
+}
@@ -0,0 +1,77 @@
+#include <r_io.h>
+#include "minbench.h"
+
+// RIO map lookup with n overlapping maps over a single malloc:// fd,
+// like a firmware image with thousands of sections
+
+#define FDSIZE 0x10000
+
+typedef struct {
+	RIO *io;
+	ut64 space;
+} MapBench;
+
+static void *setup_maps(size_t n) {
+	MapBench *b = R_NEW0 (MapBench);
+	size_t i;
+	int fd;
+	b->io = r_io_new ();
+	b->io->va = true;
+	b->space = n * 0x100;
+	fd = r_io_fd_open (b->io, "malloc://65536", R_IO_RW, 0);
+	for (i = 0; i < n; i++) {
+		ut64 size = 1 + mb_rand () % 0x400;
+		ut64 from = mb_rand () % (b->space - size);
+		r_io_map_add (b->io, fd, R_IO_READ, mb_rand () % (FDSIZE - size), from, size, false);
+	}
+	return b;
+}
+
+static void *setup_skyline(size_t n) {
+	MapBench *b = setup_maps (n);
+	r_io_map_calculate_skyline (b->io);
+	return b;
+}
+
+static void teardown_maps(void *ctx) {
+	MapBench *b = ctx;
+	r_io_free (b->io);
+	free (b);
+}
+
+static void run_skyline(void *ctx, size_t n) {
+	MapBench *b = ctx;
+	r_io_map_calculate_skyline (b->io);
+}
+
+static void run_map_get(void *ctx, size_t n) {
+	MapBench *b = ctx;
+	size_t i, sum = 0;
+	for (i = 0; i < n; i++) {
+		sum += (size_t)r_io_map_get (b->io, mb_rand () % b->space);
+	}
+	mb_sink = sum;
+}
+
+// what pd does: small reads walking the address space
+static void run_read_seq(void *ctx, size_t n) {
+	MapBench *b = ctx;
+	ut64 addr = mb_rand () % b->space;
+	ut8 buf[16];
+	size_t i;
+	for (i = 0; i < n; i++) {
+		r_io_read_at (b->io, addr, buf, sizeof (buf));
+		addr = (addr + sizeof (buf)) % b->space;
+	}
+	mb_sink = buf[0];
+}
+
+int main(int argc, char **argv) {
+	if (!mb_init (argc, argv)) {
+		return 1;
+	}
+	mb_run ("rio_map_skyline", setup_maps, run_skyline, teardown_maps, 100000);
+	mb_run ("rio_map_get", setup_skyline, run_map_get, teardown_maps, 100000);
+	mb_run ("rio_read_at_16", setup_skyline, run_read_seq, teardown_maps, 100000);
+	return mb_report ();
+}
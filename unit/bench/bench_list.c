@@ -0,0 +1,114 @@
+#include <r_util.h>
+#include "minbench.h"
+
+static int cmp_int(const void *a, const void *b) {
+	return ((size_t)a > (size_t)b) - ((size_t)a < (size_t)b);
+}
+
+static void *setup_empty(size_t n) {
+	return r_list_new ();
+}
+
+static void *setup_filled(size_t n) {
+	RList *list = r_list_new ();
+	size_t i;
+	for (i = 0; i < n; i++) {
+		r_list_append (list, (void *)i);
+	}
+	return list;
+}
+
+static void *setup_random(size_t n) {
+	RList *list = r_list_new ();
+	size_t i;
+	for (i = 0; i < n; i++) {
+		r_list_append (list, (void *)(size_t)(mb_rand () % (n * 4)));
+	}
+	return list;
+}
+
+static void teardown_list(void *list) {
+	r_list_free (list);
+}
+
+static void run_append(void *list, size_t n) {
+	size_t i;
+	for (i = 0; i < n; i++) {
+		r_list_append (list, (void *)i);
+	}
+}
+
+static void run_prepend(void *list, size_t n) {
+	size_t i;
+	for (i = 0; i < n; i++) {
+		r_list_prepend (list, (void *)i);
+	}
+}
+
+static void run_pop(void *list, size_t n) {
+	size_t i, sum = 0;
+	for (i = 0; i < n; i++) {
+		sum += (size_t)r_list_pop (list);
+	}
+	mb_sink = sum;
+}
+
+static void run_pop_head(void *list, size_t n) {
+	size_t i, sum = 0;
+	for (i = 0; i < n; i++) {
+		sum += (size_t)r_list_pop_head (list);
+	}
+	mb_sink = sum;
+}
+
+// linear scans, the reason lookups in RList do not scale: n lookups in an
+// n element list, so ns/op is per lookup and grows linearly with n
+static void run_find(void *list, size_t n) {
+	size_t i, found = 0;
+	for (i = 0; i < n; i++) {
+		found += r_list_find (list, (void *)(size_t)(mb_rand () % n), cmp_int) != NULL;
+	}
+	mb_sink = found;
+}
+
+static void run_delete_data(void *list, size_t n) {
+	size_t i;
+	for (i = 0; i < n; i++) {
+		r_list_delete_data (list, (void *)(size_t)(mb_rand () % n));
+	}
+}
+
+static void run_iterate(void *ctx, size_t n) {
+	RList *list = ctx;
+	RListIter *iter;
+	size_t sum = 0;
+	void *data;
+	r_list_foreach (list, iter, data) {
+		sum += (size_t)data;
+	}
+	mb_sink = sum;
+}
+
+static void run_sort(void *list, size_t n) {
+	r_list_sort (list, cmp_int);
+}
+
+static void run_merge_sort(void *list, size_t n) {
+	r_list_merge_sort (list, cmp_int);
+}
+
+int main(int argc, char **argv) {
+	if (!mb_init (argc, argv)) {
+		return 1;
+	}
+	mb_run ("rlist_append", setup_empty, run_append, teardown_list, MB_MAX);
+	mb_run ("rlist_prepend", setup_empty, run_prepend, teardown_list, MB_MAX);
+	mb_run ("rlist_pop", setup_filled, run_pop, teardown_list, MB_MAX);
+	mb_run ("rlist_pop_head", setup_filled, run_pop_head, teardown_list, MB_MAX);
+	mb_run ("rlist_find", setup_filled, run_find, teardown_list, 10000);
+	mb_run ("rlist_delete_data", setup_filled, run_delete_data, teardown_list, 10000);
+	mb_run ("rlist_iterate", setup_filled, run_iterate, teardown_list, MB_MAX);
+	mb_run ("rlist_sort", setup_random, run_sort, teardown_list, 10000);
+	mb_run ("rlist_merge_sort", setup_random, run_merge_sort, teardown_list, MB_MAX);
+	return mb_report ();
+}
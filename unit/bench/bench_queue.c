@@ -0,0 +1,130 @@
+#include <r_util.h>
+#include <r_th.h>
+#include "minbench.h"
+
+// RQueue alone and as a producer/consumer channel behind an RThreadLock,
+// the throughput a lock-free queue has to beat
+
+#define THREADS 2
+
+static void *setup_queue(size_t n) {
+	return r_queue_new (16);
+}
+
+static void *setup_filled(size_t n) {
+	RQueue *q = r_queue_new (16);
+	size_t i;
+	for (i = 0; i < n; i++) {
+		r_queue_enqueue (q, (void *)(i + 1));
+	}
+	return q;
+}
+
+static void teardown_queue(void *q) {
+	r_queue_free (q);
+}
+
+static void run_enqueue(void *q, size_t n) {
+	size_t i;
+	for (i = 0; i < n; i++) {
+		r_queue_enqueue (q, (void *)(i + 1));
+	}
+}
+
+static void run_dequeue(void *q, size_t n) {
+	size_t i, sum = 0;
+	for (i = 0; i < n; i++) {
+		sum += (size_t)r_queue_dequeue (q);
+	}
+	mb_sink = sum;
+}
+
+// a short queue kept busy, as in a work list
+static void run_interleaved(void *q, size_t n) {
+	size_t i, sum = 0;
+	for (i = 0; i < n; i++) {
+		r_queue_enqueue (q, (void *)(i + 1));
+		r_queue_enqueue (q, (void *)(i + 2));
+		sum += (size_t)r_queue_dequeue (q);
+		sum += (size_t)r_queue_dequeue (q);
+	}
+	mb_sink = sum;
+}
+
+typedef struct {
+	RQueue *queue;
+	RThreadLock *lock;
+	size_t items;
+	size_t consumed;
+} Channel;
+
+static void *setup_channel(size_t n) {
+	Channel *ch = R_NEW0 (Channel);
+	ch->queue = r_queue_new (1024);
+	ch->lock = r_th_lock_new (false);
+	ch->items = n;
+	return ch;
+}
+
+static void teardown_channel(void *ctx) {
+	Channel *ch = ctx;
+	r_th_lock_free (ch->lock);
+	r_queue_free (ch->queue);
+	free (ch);
+}
+
+static int producer(RThread *th) {
+	Channel *ch = th->user;
+	size_t i;
+	for (i = 0; i < ch->items / THREADS; i++) {
+		r_th_lock_enter (ch->lock);
+		r_queue_enqueue (ch->queue, (void *)(i + 1));
+		r_th_lock_leave (ch->lock);
+	}
+	return 0;
+}
+
+static int consumer(RThread *th) {
+	Channel *ch = th->user;
+	size_t sum = 0;
+	for (;;) {
+		void *item;
+		r_th_lock_enter (ch->lock);
+		if (ch->consumed == (ch->items / THREADS) * THREADS) {
+			r_th_lock_leave (ch->lock);
+			break;
+		}
+		item = r_queue_dequeue (ch->queue);
+		if (item) {
+			ch->consumed++;
+		}
+		r_th_lock_leave (ch->lock);
+		sum += (size_t)item;
+	}
+	mb_sink = sum;
+	return 0;
+}
+
+static void run_channel(void *ch, size_t n) {
+	RThread *th[THREADS * 2];
+	int i;
+	for (i = 0; i < THREADS; i++) {
+		th[i] = r_th_new (producer, ch, 0);
+		th[THREADS + i] = r_th_new (consumer, ch, 0);
+	}
+	for (i = 0; i < THREADS * 2; i++) {
+		r_th_wait (th[i]);
+		r_th_free (th[i]);
+	}
+}
+
+int main(int argc, char **argv) {
+	if (!mb_init (argc, argv)) {
+		return 1;
+	}
+	mb_run ("rqueue_enqueue", setup_queue, run_enqueue, teardown_queue, MB_MAX);
+	mb_run ("rqueue_dequeue", setup_filled, run_dequeue, teardown_queue, MB_MAX);
+	mb_run ("rqueue_interleaved", setup_queue, run_interleaved, teardown_queue, MB_MAX);
+	mb_run ("rqueue_locked_2p2c", setup_channel, run_channel, teardown_channel, 1000000);
+	return mb_report ();
+}
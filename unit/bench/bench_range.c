@@ -0,0 +1,101 @@
+#include <r_util.h>
+#include "minbench.h"
+
+// Basic block membership as done by the analysis: n sorted, mostly
+// contiguous blocks. The sorted array + binary search case is the
+// O(log n) reference an interval index has to reach.
+
+typedef struct {
+	RRangeTiny *bbr;
+	ut64 *ranges;
+	ut64 end;
+	size_t n;
+} RangeBench;
+
+static void *setup_ranges(size_t n) {
+	RangeBench *b = R_NEW0 (RangeBench);
+	ut64 at = 0x400000;
+	size_t i;
+	b->n = n;
+	b->bbr = r_tinyrange_new ();
+	b->ranges = malloc (n * 2 * sizeof (ut64));
+	for (i = 0; i < n; i++) {
+		at += (mb_rand () % 4)? 0: 1 + mb_rand () % 32;
+		b->ranges[i * 2] = at;
+		at += 1 + mb_rand () % 64;
+		b->ranges[i * 2 + 1] = at;
+	}
+	b->end = at;
+	return b;
+}
+
+static void *setup_filled(size_t n) {
+	RangeBench *b = setup_ranges (n);
+	size_t i;
+	for (i = 0; i < n; i++) {
+		r_tinyrange_add (b->bbr, b->ranges[i * 2], b->ranges[i * 2 + 1]);
+	}
+	return b;
+}
+
+static void teardown_ranges(void *ctx) {
+	RangeBench *b = ctx;
+	r_tinyrange_fini (b->bbr);
+	free (b->bbr);
+	free (b->ranges);
+	free (b);
+}
+
+static void run_add(void *ctx, size_t n) {
+	RangeBench *b = ctx;
+	size_t i;
+	for (i = 0; i < n; i++) {
+		r_tinyrange_add (b->bbr, b->ranges[i * 2], b->ranges[i * 2 + 1]);
+	}
+}
+
+static ut64 rand_addr(RangeBench *b) {
+	return 0x400000 + mb_rand () % (b->end - 0x400000 + 1);
+}
+
+// n lookups in n blocks, ns/op is per lookup
+static void run_in(void *ctx, size_t n) {
+	RangeBench *b = ctx;
+	size_t i, hits = 0;
+	for (i = 0; i < n; i++) {
+		hits += r_tinyrange_in (b->bbr, rand_addr (b));
+	}
+	mb_sink = hits;
+}
+
+static bool sorted_in(RangeBench *b, ut64 at) {
+	size_t lo = 0, hi = b->n;
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		if (b->ranges[mid * 2 + 1] <= at) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	return lo < b->n && b->ranges[lo * 2] <= at;
+}
+
+static void run_sorted_in(void *ctx, size_t n) {
+	RangeBench *b = ctx;
+	size_t i, hits = 0;
+	for (i = 0; i < n; i++) {
+		hits += sorted_in (b, rand_addr (b));
+	}
+	mb_sink = hits;
+}
+
+int main(int argc, char **argv) {
+	if (!mb_init (argc, argv)) {
+		return 1;
+	}
+	mb_run ("rtinyrange_add", setup_ranges, run_add, teardown_ranges, 1000000);
+	mb_run ("rtinyrange_in", setup_filled, run_in, teardown_ranges, 10000);
+	mb_run ("sorted_bsearch_in", setup_filled, run_sorted_in, teardown_ranges, 1000000);
+	return mb_report ();
+}
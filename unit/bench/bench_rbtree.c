@@ -0,0 +1,103 @@
+#include <r_util.h>
+#include "minbench.h"
+
+struct Node {
+	ut64 key;
+	RBNode rb;
+};
+
+static void freefn(RBNode *a) {
+	free (container_of (a, struct Node, rb));
+}
+
+static int cmp(const void *a, const RBNode *b) {
+	ut64 x = ((const struct Node *)a)->key;
+	ut64 y = container_of (b, const struct Node, rb)->key;
+	return (x > y) - (x < y);
+}
+
+static struct Node *make(ut64 key) {
+	struct Node *x = R_NEW (struct Node);
+	x->key = key;
+	return x;
+}
+
+static void *setup_empty(size_t n) {
+	return R_NEW0 (RBNode *);
+}
+
+static void *setup_filled(size_t n) {
+	RBNode **tree = R_NEW0 (RBNode *);
+	size_t i;
+	for (i = 0; i < n; i++) {
+		struct Node *x = make (i);
+		r_rbtree_insert (tree, x, &x->rb, cmp);
+	}
+	return tree;
+}
+
+static void teardown_tree(void *tree) {
+	r_rbtree_free (*(RBNode **)tree, freefn);
+	free (tree);
+}
+
+static void run_insert_seq(void *tree, size_t n) {
+	size_t i;
+	for (i = 0; i < n; i++) {
+		struct Node *x = make (i);
+		r_rbtree_insert (tree, x, &x->rb, cmp);
+	}
+}
+
+static void run_insert_random(void *tree, size_t n) {
+	size_t i;
+	for (i = 0; i < n; i++) {
+		struct Node *x = make (mb_rand ());
+		r_rbtree_insert (tree, x, &x->rb, cmp);
+	}
+}
+
+static void run_lower_bound(void *tree, size_t n) {
+	size_t i, sum = 0;
+	struct Node *x;
+	RBIter it;
+	for (i = 0; i < n; i++) {
+		struct Node key = {.key = mb_rand () % n};
+		it = r_rbtree_lower_bound_forward (*(RBNode **)tree, &key, cmp);
+		r_rbtree_iter_while (it, x, struct Node, rb) {
+			sum += x->key;
+			break;
+		}
+	}
+	mb_sink = sum;
+}
+
+static void run_delete(void *tree, size_t n) {
+	size_t i;
+	for (i = 0; i < n; i++) {
+		struct Node key = {.key = i};
+		r_rbtree_aug_delete (tree, &key, cmp, freefn, NULL);
+	}
+}
+
+static void run_iterate(void *tree, size_t n) {
+	size_t sum = 0;
+	struct Node *x;
+	RBIter it;
+	r_rbtree_foreach (*(RBNode **)tree, it, x, struct Node, rb) {
+		sum += x->key;
+	}
+	mb_sink = sum;
+}
+
+int main(int argc, char **argv) {
+	if (!mb_init (argc, argv)) {
+		return 1;
+	}
+	mb_run ("rbtree_insert_seq", setup_empty, run_insert_seq, teardown_tree, MB_MAX);
+	mb_run ("rbtree_insert_random", setup_empty, run_insert_random, teardown_tree, MB_MAX);
+	mb_run ("rbtree_lower_bound", setup_filled, run_lower_bound, teardown_tree, MB_MAX);
+	mb_run ("rbtree_delete", setup_filled, run_delete, teardown_tree, MB_MAX);
+	mb_run ("rbtree_iterate", setup_filled, run_iterate, teardown_tree, MB_MAX);
+	return mb_report ();
+}
@@ -0,0 +1,105 @@
+#include <r_search.h>
+#include "minbench.h"
+
+// r_regex and R_SEARCH_REGEXP throughput over n bytes of text-like data
+// (ns/op is per byte), for the pattern shapes used with /e
+
+typedef struct {
+	char *text;
+	RSearch *rs;
+	RRegex *rx;
+	size_t hits;
+} RegexBench;
+
+static int hit(RSearchKeyword *kw, void *user, ut64 addr) {
+	((RegexBench *)user)->hits++;
+	return 1;
+}
+
+// printable noise with an occasional "Test" and "ELF"
+static char *make_text(size_t n) {
+	char *text = malloc (n + 1);
+	size_t i;
+	for (i = 0; i < n; i++) {
+		text[i] = 'a' + mb_rand () % 26;
+		if (!(mb_rand () % 4096) && i + 4 < n) {
+			memcpy (text + i, (mb_rand () & 1)? "Test": "ELF\x01", 4);
+			i += 3;
+		}
+	}
+	text[n] = 0;
+	return text;
+}
+
+static RegexBench *setup_regex(size_t n, const char *pattern, const char *flags) {
+	RegexBench *b = R_NEW0 (RegexBench);
+	b->text = make_text (n);
+	b->rx = r_regex_new (pattern, flags);
+	b->rs = r_search_new (R_SEARCH_REGEXP);
+	r_search_set_callback (b->rs, &hit, b);
+	r_search_kw_add (b->rs, r_search_keyword_new_str (pattern, NULL, NULL, strchr (flags, 'i') != NULL));
+	r_search_begin (b->rs);
+	return b;
+}
+
+static void *setup_literal(size_t n) {
+	return setup_regex (n, "Test", "e");
+}
+
+static void *setup_icase(size_t n) {
+	return setup_regex (n, "test", "ei");
+}
+
+static void *setup_class(size_t n) {
+	return setup_regex (n, "[A-Z][a-z]+t", "e");
+}
+
+static void *setup_alternation(size_t n) {
+	return setup_regex (n, "Test|ELF|foo|bar|baz", "e");
+}
+
+static void *setup_pathological(size_t n) {
+	return setup_regex (n, "(a|aa)+z", "e");
+}
+
+static void teardown_regex(void *ctx) {
+	RegexBench *b = ctx;
+	r_regex_free (b->rx);
+	r_search_free (b->rs);
+	free (b->text);
+	free (b);
+}
+
+// all matches of the pattern, as r_regex_exec callers loop over a buffer
+static void run_exec(void *ctx, size_t n) {
+	RegexBench *b = ctx;
+	const char *p = b->text;
+	RRegexMatch m;
+	size_t hits = 0;
+	while (*p && !r_regex_exec (b->rx, p, 1, &m, 0)) {
+		hits++;
+		p += R_MAX (m.rm_eo, 1);
+	}
+	mb_sink = hits;
+}
+
+static void run_search(void *ctx, size_t n) {
+	RegexBench *b = ctx;
+	r_search_update_i (b->rs, 0, (const ut8 *)b->text, n);
+	mb_sink = b->hits;
+}
+
+int main(int argc, char **argv) {
+	if (!mb_init (argc, argv)) {
+		return 1;
+	}
+	mb_run ("rregex_exec_literal", setup_literal, run_exec, teardown_regex, MB_MAX);
+	mb_run ("rregex_exec_icase", setup_icase, run_exec, teardown_regex, MB_MAX);
+	mb_run ("rregex_exec_class", setup_class, run_exec, teardown_regex, MB_MAX);
+	mb_run ("rregex_exec_alternation", setup_alternation, run_exec, teardown_regex, MB_MAX);
+	mb_run ("rregex_exec_pathological", setup_pathological, run_exec, teardown_regex, 1000000);
+	mb_run ("rsearch_regexp_literal", setup_literal, run_search, teardown_regex, MB_MAX);
+	mb_run ("rsearch_regexp_icase", setup_icase, run_search, teardown_regex, MB_MAX);
+	mb_run ("rsearch_regexp_alternation", setup_alternation, run_search, teardown_regex, MB_MAX);
+	return mb_report ();
+}
@@ -0,0 +1,97 @@
+#include <r_search.h>
+#include "minbench.h"
+
+// RSearch keyword throughput over n bytes of random data (ns/op is per
+// byte, -m 1000000000 for a 1 GB sweep) with growing keyword counts, and
+// r_mem_mem as the single pattern reference.
+
+typedef struct {
+	RSearch *rs;
+	ut8 *buf;
+	ut8 kws[64][8];
+	size_t hits;
+} SearchBench;
+
+static int hit(RSearchKeyword *kw, void *user, ut64 addr) {
+	((SearchBench *)user)->hits++;
+	return 1;
+}
+
+static SearchBench *setup_kws(size_t n, int nkws, bool masked) {
+	SearchBench *b = R_NEW0 (SearchBench);
+	size_t i;
+	int j;
+	b->buf = malloc (n);
+	for (i = 0; i < n; i += 8) {
+		ut64 r = mb_rand ();
+		memcpy (b->buf + i, &r, R_MIN (8, n - i));
+	}
+	b->rs = r_search_new (R_SEARCH_KEYWORD);
+	r_search_set_callback (b->rs, &hit, b);
+	for (i = 0; i < nkws; i++) {
+		for (j = 0; j < 8; j++) {
+			b->kws[i][j] = mb_rand ();
+		}
+		// signature style: wildcard in the middle
+		r_search_kw_add (b->rs, r_search_keyword_new (b->kws[i], 8,
+			masked? (const ut8 *)"\xff\xff\xff\x00\x00\xff\xff\xff": NULL, masked? 8: 0, NULL));
+		// plant a hit every 64k
+		for (j = i * 4096; j + 8 < n; j += 65536) {
+			memcpy (b->buf + j, b->kws[i], 8);
+		}
+	}
+	r_search_begin (b->rs);
+	return b;
+}
+
+static void *setup_1(size_t n) {
+	return setup_kws (n, 1, false);
+}
+
+static void *setup_16(size_t n) {
+	return setup_kws (n, 16, false);
+}
+
+static void *setup_64(size_t n) {
+	return setup_kws (n, 64, false);
+}
+
+static void *setup_masked_16(size_t n) {
+	return setup_kws (n, 16, true);
+}
+
+static void teardown_search(void *ctx) {
+	SearchBench *b = ctx;
+	r_search_free (b->rs);
+	free (b->buf);
+	free (b);
+}
+
+static void run_search(void *ctx, size_t n) {
+	SearchBench *b = ctx;
+	r_search_update_i (b->rs, 0, b->buf, n);
+	mb_sink = b->hits;
+}
+
+static void run_mem_mem(void *ctx, size_t n) {
+	SearchBench *b = ctx;
+	const ut8 *p = b->buf, *end = b->buf + n;
+	size_t hits = 0;
+	while ((p = r_mem_mem (p, end - p, b->kws[0], 8))) {
+		hits++;
+		p++;
+	}
+	mb_sink = hits;
+}
+
+int main(int argc, char **argv) {
+	if (!mb_init (argc, argv)) {
+		return 1;
+	}
+	mb_run ("rsearch_kw_1", setup_1, run_search, teardown_search, MB_MAX);
+	mb_run ("rsearch_kw_16", setup_16, run_search, teardown_search, MB_MAX);
+	mb_run ("rsearch_kw_64", setup_64, run_search, teardown_search, MB_MAX);
+	mb_run ("rsearch_kw_masked_16", setup_masked_16, run_search, teardown_search, MB_MAX);
+	mb_run ("rmem_mem_1", setup_1, run_mem_mem, teardown_search, MB_MAX);
+	return mb_report ();
+}
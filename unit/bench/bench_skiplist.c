@@ -0,0 +1,76 @@
+#include <r_util.h>
+#include <r_skiplist.h>
+#include "minbench.h"
+
+static int cmp_int(const void *a, const void *b) {
+	return ((size_t)a > (size_t)b) - ((size_t)a < (size_t)b);
+}
+
+static void *setup_empty(size_t n) {
+	return r_skiplist_new (NULL, cmp_int);
+}
+
+static void *setup_filled(size_t n) {
+	RSkipList *list = r_skiplist_new (NULL, cmp_int);
+	size_t i;
+	for (i = 0; i < n; i++) {
+		r_skiplist_insert (list, (void *)i);
+	}
+	return list;
+}
+
+static void teardown_skiplist(void *list) {
+	r_skiplist_free (list);
+}
+
+static void run_insert_seq(void *list, size_t n) {
+	size_t i;
+	for (i = 0; i < n; i++) {
+		r_skiplist_insert (list, (void *)i);
+	}
+}
+
+static void run_insert_random(void *list, size_t n) {
+	size_t i;
+	for (i = 0; i < n; i++) {
+		r_skiplist_insert (list, (void *)(size_t)mb_rand ());
+	}
+}
+
+static void run_find(void *list, size_t n) {
+	size_t i, found = 0;
+	for (i = 0; i < n; i++) {
+		found += r_skiplist_find (list, (void *)(size_t)(mb_rand () % n)) != NULL;
+	}
+	mb_sink = found;
+}
+
+static void run_delete(void *list, size_t n) {
+	size_t i;
+	for (i = 0; i < n; i++) {
+		r_skiplist_delete (list, (void *)i);
+	}
+}
+
+static void run_iterate(void *ctx, size_t n) {
+	RSkipList *list = ctx;
+	RSkipListNode *it;
+	size_t sum = 0;
+	void *data;
+	r_skiplist_foreach (list, it, data) {
+		sum += (size_t)data;
+	}
+	mb_sink = sum;
+}
+
+int main(int argc, char **argv) {
+	if (!mb_init (argc, argv)) {
+		return 1;
+	}
+	mb_run ("rskiplist_insert_seq", setup_empty, run_insert_seq, teardown_skiplist, MB_MAX);
+	mb_run ("rskiplist_insert_random", setup_empty, run_insert_random, teardown_skiplist, MB_MAX);
+	mb_run ("rskiplist_find", setup_filled, run_find, teardown_skiplist, MB_MAX);
+	mb_run ("rskiplist_delete", setup_filled, run_delete, teardown_skiplist, MB_MAX);
+	mb_run ("rskiplist_iterate", setup_filled, run_iterate, teardown_skiplist, MB_MAX);
+	return mb_report ();
+}
@@ -0,0 +1,150 @@
+#include <r_util.h>
+#include <r_vector.h>
+#include "minbench.h"
+
+// Sorting symbol, string and xref sized inputs with the r_util sorts and
+// plain qsort as the reference, over the input shapes seen in analysis.
+
+enum { RANDOM, SORTED, REVERSED, FEW };
+
+typedef struct {
+	RList *list;
+	RPVector *vec;
+	size_t *array;
+	char **strs;
+	size_t n;
+} SortBench;
+
+static size_t value(int shape, size_t i, size_t n) {
+	switch (shape) {
+	case SORTED: return i;
+	case REVERSED: return n - i;
+	case FEW: return mb_rand () % 16;
+	}
+	return mb_rand () % (n * 4);
+}
+
+static int cmp_int(const void *a, const void *b) {
+	return ((size_t)a > (size_t)b) - ((size_t)a < (size_t)b);
+}
+
+static int cmp_size_t(const void *a, const void *b) {
+	return cmp_int ((void *)*(const size_t *)a, (void *)*(const size_t *)b);
+}
+
+static int cmp_str(const void *a, const void *b) {
+	return strcmp (a, b);
+}
+
+static int cmp_str_ptr(const void *a, const void *b) {
+	return strcmp (*(char * const *)a, *(char * const *)b);
+}
+
+static SortBench *setup_shape(size_t n, int shape) {
+	SortBench *b = R_NEW0 (SortBench);
+	size_t i;
+	b->n = n;
+	b->list = r_list_new ();
+	b->vec = r_pvector_new (NULL);
+	b->array = malloc (n * sizeof (size_t));
+	r_pvector_reserve (b->vec, n);
+	for (i = 0; i < n; i++) {
+		size_t v = value (shape, i, n);
+		r_list_append (b->list, (void *)v);
+		r_pvector_push (b->vec, (void *)v);
+		b->array[i] = v;
+	}
+	return b;
+}
+
+static void *setup_random(size_t n) {
+	return setup_shape (n, RANDOM);
+}
+
+static void *setup_sorted(size_t n) {
+	return setup_shape (n, SORTED);
+}
+
+static void *setup_reversed(size_t n) {
+	return setup_shape (n, REVERSED);
+}
+
+static void *setup_few(size_t n) {
+	return setup_shape (n, FEW);
+}
+
+// symbol names share long prefixes, which makes every comparison expensive
+static void *setup_strings(size_t n) {
+	static const char *prefixes[] = { "sym.imp.", "sym.", "fcn.", "str.", "reloc." };
+	SortBench *b = R_NEW0 (SortBench);
+	size_t i;
+	b->n = n;
+	b->list = r_list_new ();
+	b->vec = r_pvector_new (NULL);
+	b->strs = malloc (n * sizeof (char *));
+	r_pvector_reserve (b->vec, n);
+	for (i = 0; i < n; i++) {
+		b->strs[i] = r_str_newf ("%s%08"PFMT64x, prefixes[mb_rand () % 5], (ut64)(mb_rand () % (n * 4)));
+		r_list_append (b->list, b->strs[i]);
+		r_pvector_push (b->vec, b->strs[i]);
+	}
+	return b;
+}
+
+static void teardown_sort(void *ctx) {
+	SortBench *b = ctx;
+	size_t i;
+	r_list_free (b->list);
+	r_pvector_free (b->vec);
+	if (b->strs) {
+		for (i = 0; i < b->n; i++) {
+			free (b->strs[i]);
+		}
+	}
+	free (b->strs);
+	free (b->array);
+	free (b);
+}
+
+static void run_list_merge_sort(void *ctx, size_t n) {
+	r_list_merge_sort (((SortBench *)ctx)->list, cmp_int);
+}
+
+static void run_pvector_sort(void *ctx, size_t n) {
+	r_pvector_sort (((SortBench *)ctx)->vec, cmp_int);
+}
+
+static void run_qsort(void *ctx, size_t n) {
+	qsort (((SortBench *)ctx)->array, n, sizeof (size_t), cmp_size_t);
+}
+
+static void run_list_merge_sort_str(void *ctx, size_t n) {
+	r_list_merge_sort (((SortBench *)ctx)->list, cmp_str);
+}
+
+static void run_pvector_sort_str(void *ctx, size_t n) {
+	r_pvector_sort (((SortBench *)ctx)->vec, cmp_str);
+}
+
+static void run_qsort_str(void *ctx, size_t n) {
+	qsort (((SortBench *)ctx)->strs, n, sizeof (char *), cmp_str_ptr);
+}
+
+int main(int argc, char **argv) {
+	if (!mb_init (argc, argv)) {
+		return 1;
+	}
+	mb_run ("rlist_merge_sort_random", setup_random, run_list_merge_sort, teardown_sort, 1000000);
+	mb_run ("rlist_merge_sort_sorted", setup_sorted, run_list_merge_sort, teardown_sort, 1000000);
+	mb_run ("rlist_merge_sort_reversed", setup_reversed, run_list_merge_sort, teardown_sort, 1000000);
+	mb_run ("rlist_merge_sort_few", setup_few, run_list_merge_sort, teardown_sort, 1000000);
+	mb_run ("rpvector_sort_random", setup_random, run_pvector_sort, teardown_sort, 1000000);
+	mb_run ("rpvector_sort_sorted", setup_sorted, run_pvector_sort, teardown_sort, 1000000);
+	mb_run ("rpvector_sort_reversed", setup_reversed, run_pvector_sort, teardown_sort, 1000000);
+	mb_run ("rpvector_sort_few", setup_few, run_pvector_sort, teardown_sort, 1000000);
+	mb_run ("qsort_random", setup_random, run_qsort, teardown_sort, 1000000);
+	mb_run ("rlist_merge_sort_str", setup_strings, run_list_merge_sort_str, teardown_sort, 1000000);
+	mb_run ("rpvector_sort_str", setup_strings, run_pvector_sort_str, teardown_sort, 1000000);
+	mb_run ("qsort_str", setup_strings, run_qsort_str, teardown_sort, 1000000);
+	return mb_report ();
+}
@@ -0,0 +1,106 @@
+#include <r_core.h>
+#include "minbench.h"
+
+// r_str helpers over the output of pd n (ns/op is per disassembled line),
+// the text that ~ grep and per line command parsing go through. Every run
+// works on a fresh copy of the text, which is included in the timings.
+
+typedef struct {
+	char *text;
+	char *copy;
+	size_t len;
+} StrBench;
+
+static void *setup_pd(size_t n) {
+	StrBench *b = R_NEW0 (StrBench);
+	RCore *core = r_core_new ();
+	char *cmd;
+	r_core_cmd0 (core, "e scr.color=0;e scr.utf8=false;e asm.arch=x86;e asm.bits=64");
+	// random code is about 4 bytes per instruction
+	cmd = r_str_newf ("o+ malloc://0x%"PFMT64x" 0;wr 0x%"PFMT64x, (ut64)n * 8, (ut64)n * 8);
+	r_core_cmd0 (core, cmd);
+	free (cmd);
+	cmd = r_str_newf ("pd %d @ 0", (int)n);
+	b->text = r_core_cmd_str (core, cmd);
+	free (cmd);
+	r_core_free (core);
+	b->len = strlen (b->text);
+	b->copy = malloc (b->len + 1);
+	return b;
+}
+
+static void teardown_pd(void *ctx) {
+	StrBench *b = ctx;
+	free (b->text);
+	free (b->copy);
+	free (b);
+}
+
+static char *fresh_copy(StrBench *b) {
+	memcpy (b->copy, b->text, b->len + 1);
+	return b->copy;
+}
+
+static void run_char_count(void *ctx, size_t n) {
+	StrBench *b = ctx;
+	mb_sink = r_str_char_count (b->text, '\n');
+}
+
+static void run_word_count(void *ctx, size_t n) {
+	StrBench *b = ctx;
+	mb_sink = r_str_word_count (b->text);
+}
+
+static void run_replace_char(void *ctx, size_t n) {
+	StrBench *b = ctx;
+	char *s = fresh_copy (b);
+	r_str_replace_char (s, ';', '#');
+	mb_sink = s[0];
+}
+
+static void run_split(void *ctx, size_t n) {
+	StrBench *b = ctx;
+	mb_sink = r_str_split (fresh_copy (b), '\n');
+}
+
+// ~[1]: split in lines, then tokenize every line and take a column
+static void run_split_tokenize(void *ctx, size_t n) {
+	StrBench *b = ctx;
+	char *s = fresh_copy (b), *end = s + b->len;
+	size_t total = 0;
+	r_str_split (s, '\n');
+	while (s < end) {
+		size_t linelen = strlen (s);
+		if (r_str_word_set0 (s) > 0) {
+			total += *r_str_word_get0 (s, 1);
+		}
+		s += linelen + 1;
+	}
+	mb_sink = total;
+}
+
+static void run_lchr(void *ctx, size_t n) {
+	StrBench *b = ctx;
+	char *s = fresh_copy (b), *end = s + b->len;
+	size_t total = 0;
+	r_str_split (s, '\n');
+	while (s < end) {
+		const char *semi = r_str_lchr (s, ';');
+		total += semi? semi - s: 0;
+		s += strlen (s) + 1;
+	}
+	mb_sink = total;
+}
+
+int main(int argc, char **argv) {
+	if (!mb_init (argc, argv)) {
+		return 1;
+	}
+	mb_run ("rstr_char_count_pd", setup_pd, run_char_count, teardown_pd, 1000000);
+	mb_run ("rstr_word_count_pd", setup_pd, run_word_count, teardown_pd, 1000000);
+	mb_run ("rstr_replace_char_pd", setup_pd, run_replace_char, teardown_pd, 1000000);
+	mb_run ("rstr_split_pd", setup_pd, run_split, teardown_pd, 1000000);
+	mb_run ("rstr_split_tokenize_pd", setup_pd, run_split_tokenize, teardown_pd, 1000000);
+	mb_run ("rstr_lchr_pd", setup_pd, run_lchr, teardown_pd, 1000000);
+	return mb_report ();
+}
@@ -0,0 +1,232 @@
+#include <r_util.h>
+#include <r_vector.h>
+#include "minbench.h"
+
+static void *setup_empty(size_t n) {
+	return r_vector_new (sizeof (ut32), NULL, NULL);
+}
+
+static void *setup_filled(size_t n) {
+	RVector *v = r_vector_new (sizeof (ut32), NULL, NULL);
+	ut32 i;
+	r_vector_reserve (v, n);
+	for (i = 0; i < n; i++) {
+		r_vector_push (v, &i);
+	}
+	return v;
+}
+
+static void teardown_vector(void *v) {
+	r_vector_free (v);
+}
+
+static void run_push(void *v, size_t n) {
+	ut32 i;
+	for (i = 0; i < n; i++) {
+		r_vector_push (v, &i);
+	}
+}
+
+static void run_push_reserved(void *v, size_t n) {
+	r_vector_reserve (v, n);
+	run_push (v, n);
+}
+
+static void run_push_front(void *v, size_t n) {
+	ut32 i;
+	for (i = 0; i < n; i++) {
+		r_vector_push_front (v, &i);
+	}
+}
+
+static void run_insert_mid(void *v, size_t n) {
+	ut32 i;
+	for (i = 0; i < n; i++) {
+		r_vector_insert (v, ((RVector *)v)->len / 2, &i);
+	}
+}
+
+static void run_pop(void *v, size_t n) {
+	ut32 e;
+	size_t i;
+	for (i = 0; i < n; i++) {
+		r_vector_pop (v, &e);
+	}
+	mb_sink = e;
+}
+
+static void run_remove_mid(void *v, size_t n) {
+	ut32 e;
+	size_t i;
+	for (i = 0; i < n; i++) {
+		r_vector_remove_at (v, ((RVector *)v)->len / 2, &e);
+	}
+	mb_sink = e;
+}
+
+static void run_index_random(void *v, size_t n) {
+	ut64 sum = 0;
+	size_t i;
+	for (i = 0; i < n; i++) {
+		sum += *(ut32 *)r_vector_index_ptr (v, mb_rand () % n);
+	}
+	mb_sink = sum;
+}
+
+static void run_iterate(void *v, size_t n) {
+	ut64 sum = 0;
+	size_t i;
+	for (i = 0; i < ((RVector *)v)->len; i++) {
+		sum += *(ut32 *)r_vector_index_ptr (v, i);
+	}
+	mb_sink = sum;
+}
+
+static void *setup_pvector_empty(size_t n) {
+	return r_pvector_new (NULL);
+}
+
+static void *setup_pvector_sorted(size_t n) {
+	RPVector *v = r_pvector_new (NULL);
+	size_t i;
+	r_pvector_reserve (v, n);
+	for (i = 0; i < n; i++) {
+		r_pvector_push (v, (void *)(i * 2));
+	}
+	return v;
+}
+
+static void *setup_pvector_random(size_t n) {
+	RPVector *v = r_pvector_new (NULL);
+	size_t i;
+	r_pvector_reserve (v, n);
+	for (i = 0; i < n; i++) {
+		r_pvector_push (v, (void *)(size_t)(mb_rand () % (n * 4)));
+	}
+	return v;
+}
+
+static void teardown_pvector(void *v) {
+	r_pvector_free (v);
+}
+
+static void run_pvector_push(void *v, size_t n) {
+	size_t i;
+	for (i = 0; i < n; i++) {
+		r_pvector_push (v, (void *)i);
+	}
+}
+
+#define CMP(x, y) ((x) < (y)? -1: (x) > (y))
+
+static void run_pvector_lower_bound(void *ctx, size_t n) {
+	RPVector *v = ctx;
+	size_t i, l, sum = 0;
+	for (i = 0; i < n; i++) {
+		void *x = (void *)(size_t)(mb_rand () % (n * 2));
+		r_pvector_lower_bound (v, x, l, CMP);
+		sum += l;
+	}
+	mb_sink = sum;
+}
+
+static int cmp_ptr(const void *a, const void *b) {
+	return CMP (a, b);
+}
+
+static void run_pvector_sort(void *v, size_t n) {
+	r_pvector_sort (v, cmp_ptr);
+}
+
+static void run_pvector_iterate(void *ctx, size_t n) {
+	RPVector *v = ctx;
+	size_t sum = 0;
+	void **it;
+	r_pvector_foreach (v, it) {
+		sum += (size_t)*it;
+	}
+	mb_sink = sum;
+}
+
+// n short lived vectors of a few elements, like per-op and per-block data
+static void run_tiny(size_t n, ut32 k) {
+	ut64 sum = 0;
+	size_t i;
+	ut32 j;
+	for (i = 0; i < n; i++) {
+		RVector v;
+		r_vector_init (&v, sizeof (ut32), NULL, NULL);
+		for (j = 0; j < k; j++) {
+			r_vector_push (&v, &j);
+		}
+		sum += v.len;
+		r_vector_clear (&v);
+	}
+	mb_sink = sum;
+}
+
+static void run_tiny_2(void *ctx, size_t n) {
+	run_tiny (n, 2);
+}
+
+static void run_tiny_4(void *ctx, size_t n) {
+	run_tiny (n, 4);
+}
+
+static void run_tiny_8(void *ctx, size_t n) {
+	run_tiny (n, 8);
+}
+
+static void run_tiny_new_8(void *ctx, size_t n) {
+	ut64 sum = 0;
+	size_t i;
+	ut32 j;
+	for (i = 0; i < n; i++) {
+		RVector *v = r_vector_new (sizeof (ut32), NULL, NULL);
+		for (j = 0; j < 8; j++) {
+			r_vector_push (v, &j);
+		}
+		sum += v->len;
+		r_vector_free (v);
+	}
+	mb_sink = sum;
+}
+
+// what inline storage would cost: no allocation at all
+static void run_tiny_stack_8(void *ctx, size_t n) {
+	ut64 sum = 0;
+	size_t i;
+	ut32 j;
+	for (i = 0; i < n; i++) {
+		volatile ut32 a[8];
+		for (j = 0; j < 8; j++) {
+			a[j] = j;
+		}
+		sum += a[7];
+	}
+	mb_sink = sum;
+}
+
+int main(int argc, char **argv) {
+	if (!mb_init (argc, argv)) {
+		return 1;
+	}
+	mb_run ("rvector_push", setup_empty, run_push, teardown_vector, MB_MAX);
+	mb_run ("rvector_push_reserved", setup_empty, run_push_reserved, teardown_vector, MB_MAX);
+	mb_run ("rvector_push_front", setup_empty, run_push_front, teardown_vector, 100000);
+	mb_run ("rvector_insert_mid", setup_empty, run_insert_mid, teardown_vector, 100000);
+	mb_run ("rvector_pop", setup_filled, run_pop, teardown_vector, MB_MAX);
+	mb_run ("rvector_remove_mid", setup_filled, run_remove_mid, teardown_vector, 100000);
+	mb_run ("rvector_index_random", setup_filled, run_index_random, teardown_vector, MB_MAX);
+	mb_run ("rvector_iterate", setup_filled, run_iterate, teardown_vector, MB_MAX);
+	mb_run ("rpvector_push", setup_pvector_empty, run_pvector_push, teardown_pvector, MB_MAX);
+	mb_run ("rpvector_lower_bound", setup_pvector_sorted, run_pvector_lower_bound, teardown_pvector, MB_MAX);
+	mb_run ("rpvector_sort", setup_pvector_random, run_pvector_sort, teardown_pvector, MB_MAX);
+	mb_run ("rpvector_iterate", setup_pvector_sorted, run_pvector_iterate, teardown_pvector, MB_MAX);
+	mb_run ("rvector_tiny_2", NULL, run_tiny_2, NULL, MB_MAX);
+	mb_run ("rvector_tiny_4", NULL, run_tiny_4, NULL, MB_MAX);
+	mb_run ("rvector_tiny_8", NULL, run_tiny_8, NULL, MB_MAX);
+	mb_run ("rvector_tiny_new_8", NULL, run_tiny_new_8, NULL, MB_MAX);
+	mb_run ("stack_array_8", NULL, run_tiny_stack_8, NULL, MB_MAX);
+	return mb_report ();
+}
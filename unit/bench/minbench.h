@@ -0,0 +1,213 @@
+// minbench.h - a minunit-style timing harness for the r_util benchmarks
+//
+// Every benchmark case is run `reps` times on a freshly set up input and the
+// per-run wall clock times are summarized as min/p50/p90/p99/mean. Results are
+// printed as they are measured and can be written as JSON (-j) and compared
+// against a previously saved JSON baseline (-c), in which case the exit code
+// is non-zero if any case got slower than the threshold (-t, in percent).
+//
+//   ./bench_vector -r 9 -m 1000000 -j vector.json
+//   ./bench_vector -c vector.json -t 15
+//
+// A case is a setup/run/teardown triple, only `run` is timed:
+//
+//   static void *setup(size_t n) { ... return ctx; }
+//   static void run(void *ctx, size_t n) { ... }
+//   static void teardown(void *ctx) { ... }
+//
+//   mb_run ("rvector_push", setup, run, teardown, MB_MAX);
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define MB_MAX 0
+#define MB_MAX_RESULTS 512
+#define MB_MAX_REPS 101
+
+typedef void *(*MBSetup)(size_t n);
+typedef void (*MBRun)(void *ctx, size_t n);
+typedef void (*MBTeardown)(void *ctx);
+
+typedef struct {
+	char name[64];
+	size_t n;
+	int reps;
+	double min, p50, p90, p99, mean;
+} MBResult;
+
+// sizes above the default -m are only run on request, e.g. -m 1000000000
+static const size_t mb_sizes[] = { 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000 };
+
+static int mb_reps = 5;
+static size_t mb_maxn = 10000000;
+static double mb_threshold = 10.0;
+static const char *mb_json = NULL;
+static const char *mb_baseline = NULL;
+static const char *mb_filter = NULL;
+static MBResult mb_results[MB_MAX_RESULTS];
+static int mb_nresults = 0;
+static ut64 mb_seed = 0x2545f4914f6cdd1dULL;
+
+// deterministic xorshift64 so that runs are comparable across commits
+static inline ut64 mb_rand(void) {
+	mb_seed ^= mb_seed << 13;
+	mb_seed ^= mb_seed >> 7;
+	mb_seed ^= mb_seed << 17;
+	return mb_seed;
+}
+
+static inline double mb_now_ns(void) {
+	struct timespec ts;
+	clock_gettime (CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// keeps the compiler from optimizing away the benchmarked work
+static volatile ut64 mb_sink;
+
+static int mb_cmp_double(const void *a, const void *b) {
+	double x = *(const double *)a, y = *(const double *)b;
+	return (x > y) - (x < y);
+}
+
+static double mb_percentile(const double *sorted, int count, double q) {
+	return sorted[(int)(q * (count - 1) + 0.5)];
+}
+
+static void mb_usage(const char *argv0) {
+	printf ("Usage: %s [-r reps] [-m maxn] [-f filter] [-j out.json] [-c baseline.json] [-t pct]\n", argv0);
+}
+
+static bool mb_init(int argc, char **argv) {
+	int i;
+	for (i = 1; i < argc; i++) {
+		const char *arg = argv[i];
+		const char *val = (i + 1 < argc)? argv[i + 1]: NULL;
+		if (arg[0] != '-' || !arg[1] || arg[2] || !val) {
+			mb_usage (argv[0]);
+			return false;
+		}
+		switch (arg[1]) {
+		case 'r': mb_reps = R_MAX (1, R_MIN (atoi (val), MB_MAX_REPS)); break;
+		case 'm': mb_maxn = strtoull (val, NULL, 0); break;
+		case 'f': mb_filter = val; break;
+		case 'j': mb_json = val; break;
+		case 'c': mb_baseline = val; break;
+		case 't': mb_threshold = atof (val); break;
+		default:
+			mb_usage (argv[0]);
+			return false;
+		}
+		i++;
+	}
+	return true;
+}
+
+// runs one case for every size up to min(maxn, -m), maxn = MB_MAX means no case specific limit
+static void mb_run(const char *name, MBSetup setup, MBRun run, MBTeardown teardown, size_t maxn) {
+	double samples[MB_MAX_REPS];
+	size_t s;
+	int i;
+	if (mb_filter && !strstr (name, mb_filter)) {
+		return;
+	}
+	for (s = 0; s < sizeof (mb_sizes) / sizeof (mb_sizes[0]); s++) {
+		size_t n = mb_sizes[s];
+		MBResult *r;
+		if (n > mb_maxn || (maxn != MB_MAX && n > maxn) || mb_nresults >= MB_MAX_RESULTS) {
+			break;
+		}
+		r = &mb_results[mb_nresults++];
+		snprintf (r->name, sizeof (r->name), "%s", name);
+		r->n = n;
+		r->reps = mb_reps;
+		r->mean = 0;
+		for (i = 0; i < mb_reps; i++) {
+			void *ctx = setup? setup (n): NULL;
+			double t = mb_now_ns ();
+			run (ctx, n);
+			samples[i] = mb_now_ns () - t;
+			r->mean += samples[i] / mb_reps;
+			if (teardown) {
+				teardown (ctx);
+			}
+		}
+		qsort (samples, mb_reps, sizeof (double), mb_cmp_double);
+		r->min = samples[0];
+		r->p50 = mb_percentile (samples, mb_reps, 0.50);
+		r->p90 = mb_percentile (samples, mb_reps, 0.90);
+		r->p99 = mb_percentile (samples, mb_reps, 0.99);
+		printf ("%-32s n=%-9zu p50 %10.2f ns/op  (min %.2f, p90 %.2f, p99 %.2f)\n",
+			r->name, n, r->p50 / n, r->min / n, r->p90 / n, r->p99 / n);
+		fflush (stdout);
+	}
+}
+
+static bool mb_write_json(const char *path) {
+	int i;
+	FILE *fd = fopen (path, "w");
+	if (!fd) {
+		perror (path);
+		return false;
+	}
+	fprintf (fd, "[\n");
+	for (i = 0; i < mb_nresults; i++) {
+		const MBResult *r = &mb_results[i];
+		// one result per line, mb_compare relies on it
+		fprintf (fd, "{\"name\":\"%s\",\"n\":%zu,\"reps\":%d,\"min_ns\":%.0f,\"p50_ns\":%.0f,"
+			"\"p90_ns\":%.0f,\"p99_ns\":%.0f,\"mean_ns\":%.0f,\"ns_per_op\":%.3f}%s\n",
+			r->name, r->n, r->reps, r->min, r->p50, r->p90, r->p99, r->mean,
+			r->p50 / r->n, (i + 1 < mb_nresults)? ",": "");
+	}
+	fprintf (fd, "]\n");
+	fclose (fd);
+	return true;
+}
+
+// compares the p50 of every case against the baseline, returns the number of regressions
+static int mb_compare(const char *path) {
+	char line[512], name[64];
+	size_t n;
+	double p50;
+	int i, regressions = 0;
+	FILE *fd = fopen (path, "r");
+	if (!fd) {
+		perror (path);
+		return 1;
+	}
+	while (fgets (line, sizeof (line), fd)) {
+		if (sscanf (line, "{\"name\":\"%63[^\"]\",\"n\":%zu,\"reps\":%*d,\"min_ns\":%*f,\"p50_ns\":%lf",
+				name, &n, &p50) != 3) {
+			continue;
+		}
+		for (i = 0; i < mb_nresults; i++) {
+			const MBResult *r = &mb_results[i];
+			double delta;
+			if (r->n != n || strcmp (r->name, name)) {
+				continue;
+			}
+			delta = (r->p50 - p50) * 100.0 / p50;
+			if (delta > mb_threshold) {
+				regressions++;
+			}
+			printf ("%-32s n=%-9zu %10.2f -> %10.2f ns/op  %+6.1f%%%s\n", name, n,
+				p50 / n, r->p50 / n, delta, (delta > mb_threshold)? "  REGRESSION": "");
+		}
+	}
+	fclose (fd);
+	return regressions;
+}
+
+static int mb_report(void) {
+	int ret = 0;
+	// compare first, the baseline may be overwritten by -j
+	if (mb_baseline && mb_compare (mb_baseline) > 0) {
+		ret = 1;
+	}
+	if (mb_json && !mb_write_json (mb_json)) {
+		ret = 1;
+	}
+	return ret;
+}
@@ -41,12 +41,90 @@ int test_r_base64_encode(void) {
 	mu_end;
 }
 
+// RFC 4648 test vectors
+static const char *rfc_vectors[][2] = {
+	{ "", "" },
+	{ "f", "Zg==" },
+	{ "fo", "Zm8=" },
+	{ "foo", "Zm9v" },
+	{ "foob", "Zm9vYg==" },
+	{ "fooba", "Zm9vYmE=" },
+	{ "foobar", "Zm9vYmFy" },
+};
+
+bool test_r_base64_rfc4648(void) {
+	char enc[16];
+	ut8 dec[16];
+	int i;
+	for (i = 0; i < R_ARRAY_SIZE (rfc_vectors); i++) {
+		const char *plain = rfc_vectors[i][0], *b64 = rfc_vectors[i][1];
+		mu_assert_eq (r_base64_encode (enc, (const ut8 *)plain, strlen (plain)), (int)strlen (b64), b64);
+		mu_assert_streq (enc, b64, plain);
+		if (*b64) {
+			memset (dec, 0, sizeof (dec));
+			mu_assert_eq (r_base64_decode (dec, b64, -1), (int)strlen (plain), b64);
+			mu_assert_streq ((char *)dec, plain, b64);
+		}
+	}
+	mu_end;
+}
+
+// binary data with embedded zeros, at every length around the 3 byte
+// groups and any vector width
+bool test_r_base64_roundtrip(void) {
+	// decoding writes whole 3 byte groups and a trailing zero
+	ut8 bin[300], dec[300 + 3];
+	char enc[401], msg[64];
+	int i, len;
+	for (i = 0; i < sizeof (bin); i++) {
+		bin[i] = (i * 151) ^ (i >> 3);
+	}
+	for (len = 1; len <= sizeof (bin); len++) {
+		int enclen = r_base64_encode (enc, bin, len);
+		snprintf (msg, sizeof (msg), "roundtrip of %d bytes", len);
+		mu_assert_eq (enclen, (len + 2) / 3 * 4, msg);
+		mu_assert_eq ((int)strlen (enc), enclen, msg);
+		mu_assert_eq (r_base64_decode (dec, enc, enclen), len, msg);
+		mu_assert (msg, !memcmp (dec, bin, len));
+	}
+	mu_end;
+}
+
+// decoding the encoded text in pieces of any multiple of 4 characters
+// gives the same bytes as decoding it at once
+bool test_r_base64_decode_chunks(void) {
+	ut8 bin[256], dec[256 + 3];
+	char enc[345], msg[64];
+	int i, chunk, enclen;
+	for (i = 0; i < sizeof (bin); i++) {
+		bin[i] = 255 - i;
+	}
+	enclen = r_base64_encode (enc, bin, sizeof (bin));
+	for (chunk = 4; chunk <= 64; chunk += 4) {
+		int pos, out = 0;
+		memset (dec, 0, sizeof (dec));
+		for (pos = 0; pos < enclen; pos += chunk) {
+			int n = r_base64_decode (dec + out, enc + pos, R_MIN (chunk, enclen - pos));
+			snprintf (msg, sizeof (msg), "chunk of %d at %d", chunk, pos);
+			mu_assert (msg, n > 0);
+			out += n;
+		}
+		snprintf (msg, sizeof (msg), "chunks of %d characters", chunk);
+		mu_assert_eq (out, (int)sizeof (bin), msg);
+		mu_assert_memeq (dec, bin, sizeof (bin), msg);
+	}
+	mu_end;
+}
+
 int all_tests() {
 	mu_run_test(test_r_base64_decode_dyn);
 	mu_run_test(test_r_base64_decode);
 	mu_run_test(test_r_base64_decode_invalid);
 	mu_run_test(test_r_base64_encode_dyn);
 	mu_run_test(test_r_base64_encode);
+	mu_run_test(test_r_base64_rfc4648);
+	mu_run_test(test_r_base64_roundtrip);
+	mu_run_test(test_r_base64_decode_chunks);
 	return tests_passed != tests_run;
 }
 
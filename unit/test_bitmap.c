@@ -25,8 +25,72 @@ bool test_r_bitmap_set(void) {
 	mu_end;
 }
 
+// bits around every 32 and 64 bit word boundary, and the last one
+bool test_r_bitmap_word_boundaries(void) {
+	static const int sizes[] = { 1, 31, 32, 33, 63, 64, 65, 127, 128, 129, 1000 };
+	int i, j, k;
+	for (i = 0; i < R_ARRAY_SIZE (sizes); i++) {
+		const int n = sizes[i];
+		RBitmap *bitmap = r_bitmap_new (n);
+		mu_assert ("bitmap allocated", bitmap);
+		for (j = 0; j < n; j++) {
+			mu_assert_eq (!!r_bitmap_test (bitmap, j), false, "new bitmap is clear");
+		}
+		for (j = 0; j < n; j++) {
+			if (j % 32 && (j + 1) % 32 && j != n - 1) {
+				continue;
+			}
+			r_bitmap_set (bitmap, j);
+			for (k = 0; k < n; k++) {
+				mu_assert_eq (!!r_bitmap_test (bitmap, k), k == j, "only the set bit is set");
+			}
+			r_bitmap_unset (bitmap, j);
+			mu_assert_eq (!!r_bitmap_test (bitmap, j), false, "bit unset");
+		}
+		r_bitmap_free (bitmap);
+	}
+	mu_end;
+}
+
+bool test_r_bitmap_random(void) {
+	const int n = 4099;
+	RBitmap *bitmap = r_bitmap_new (n);
+	ut8 *oracle = calloc (n, 1);
+	int i;
+	srand (1337);
+	for (i = 0; i < 100000; i++) {
+		int bit = rand () % n;
+		if (rand () & 1) {
+			r_bitmap_set (bitmap, bit);
+			oracle[bit] = 1;
+		} else {
+			r_bitmap_unset (bitmap, bit);
+			oracle[bit] = 0;
+		}
+	}
+	for (i = 0; i < n; i++) {
+		mu_assert_eq (!!r_bitmap_test (bitmap, i), oracle[i], "same bits as the byte array");
+	}
+	// setting and unsetting twice is idempotent
+	for (i = 0; i < n; i++) {
+		r_bitmap_set (bitmap, i);
+		r_bitmap_set (bitmap, i);
+	}
+	for (i = 0; i < n; i++) {
+		mu_assert_eq (!!r_bitmap_test (bitmap, i), true, "all bits set");
+		r_bitmap_unset (bitmap, i);
+		r_bitmap_unset (bitmap, i);
+		mu_assert_eq (!!r_bitmap_test (bitmap, i), false, "bit unset twice");
+	}
+	free (oracle);
+	r_bitmap_free (bitmap);
+	mu_end;
+}
+
 int all_tests() {
 	mu_run_test(test_r_bitmap_set);
+	mu_run_test(test_r_bitmap_word_boundaries);
+	mu_run_test(test_r_bitmap_random);
 	return tests_passed != tests_run;
 }
 
@@ -62,8 +62,114 @@ bool test_r_diff_buffers_distance(void) {
 	mu_end;
 }
 
+// reference O(la*lb) dynamic programming, with or without substitutions
+static ut32 naive_distance(const ut8 *a, ut32 la, const ut8 *b, ut32 lb, bool subst) {
+	ut32 *row = malloc ((lb + 1) * sizeof (ut32));
+	ut32 i, j, diag, tmp, ret;
+	for (j = 0; j <= lb; j++) {
+		row[j] = j;
+	}
+	for (i = 1; i <= la; i++) {
+		diag = row[0];
+		row[0] = i;
+		for (j = 1; j <= lb; j++) {
+			tmp = row[j];
+			if (a[i - 1] == b[j - 1]) {
+				row[j] = diag;
+			} else {
+				row[j] = R_MIN (row[j], row[j - 1]) + 1;
+				if (subst) {
+					row[j] = R_MIN (row[j], diag + 1);
+				}
+			}
+			diag = tmp;
+		}
+	}
+	ret = row[lb];
+	free (row);
+	return ret;
+}
+
+// b is a with random edits, over a small alphabet so that distances are
+// not simply max(la, lb)
+static ut32 mutate(const ut8 *a, ut32 la, ut8 *b, int alphabet) {
+	ut32 i, lb = 0;
+	for (i = 0; i < la; i++) {
+		switch (rand () % 8) {
+		case 0: // delete
+			break;
+		case 1: // insert
+			b[lb++] = rand () % alphabet;
+			b[lb++] = a[i];
+			break;
+		case 2: // substitute
+			b[lb++] = rand () % alphabet;
+			break;
+		default:
+			b[lb++] = a[i];
+		}
+	}
+	return lb;
+}
+
+bool test_r_diff_buffers_distance_random(void) {
+	static const int alphabets[] = { 2, 4, 256 };
+	ut8 a[300], b[600];
+	char msg[128];
+	RDiff *diff = r_diff_new ();
+	ut32 distance, la, lb, i;
+	int round;
+	srand (1337);
+	for (round = 0; round < 300; round++) {
+		int alphabet = alphabets[round % R_ARRAY_SIZE (alphabets)];
+		// lengths around the 64 bit word size of bit-parallel algorithms
+		la = round % 3? rand () % 140: rand () % 300;
+		for (i = 0; i < la; i++) {
+			a[i] = rand () % alphabet;
+		}
+		lb = mutate (a, la, b, alphabet);
+
+		diff->type = '\0';
+		r_diff_buffers_distance (diff, a, la, b, lb, &distance, NULL);
+		snprintf (msg, sizeof msg, "original distance, round %d (%u/%u bytes)", round, la, lb);
+		mu_assert_eq (distance, naive_distance (a, la, b, lb, true), msg);
+
+		diff->type = 'm';
+		r_diff_buffers_distance (diff, a, la, b, lb, &distance, NULL);
+		snprintf (msg, sizeof msg, "myers distance, round %d (%u/%u bytes)", round, la, lb);
+		mu_assert_eq (distance, naive_distance (a, la, b, lb, false), msg);
+	}
+	r_diff_free (diff);
+	mu_end;
+}
+
+bool test_r_diff_buffers_similarity(void) {
+	ut8 a[256], b[256];
+	RDiff *diff = r_diff_new ();
+	ut32 distance;
+	double similarity;
+	int i;
+	for (i = 0; i < sizeof (a); i++) {
+		a[i] = b[i] = i;
+	}
+	diff->type = '\0';
+	r_diff_buffers_distance (diff, a, sizeof (a), b, sizeof (b), &distance, &similarity);
+	mu_assert_eq (distance, 0, "identical buffers");
+	mu_assert ("identical buffers are similar", fabs (similarity - 1.0) < 1e-9);
+	for (i = 0; i < 64; i++) {
+		b[i * 4] ^= 0xff;
+	}
+	r_diff_buffers_distance (diff, a, sizeof (a), b, sizeof (b), &distance, &similarity);
+	mu_assert_eq (distance, 64, "one substitution every 4 bytes");
+	mu_assert ("similarity of a quarter changed buffer", fabs (similarity - 0.75) < 1e-9);
+	r_diff_free (diff);
+	mu_end;
+}
+
 int all_tests() {
 	mu_run_test(test_r_diff_buffers_distance);
+	mu_run_test(test_r_diff_buffers_distance_random);
+	mu_run_test(test_r_diff_buffers_similarity);
 	return tests_passed != tests_run;
 }
 
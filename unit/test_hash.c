@@ -0,0 +1,110 @@
+#include <r_hash.h>
+#include <r_util.h>
+#include "minunit.h"
+
+typedef struct {
+	ut64 algo;
+	int size;
+	const char *name;
+} HashAlgo;
+
+static const HashAlgo algos[] = {
+	{ R_HASH_MD5, R_HASH_SIZE_MD5, "md5" },
+	{ R_HASH_SHA1, R_HASH_SIZE_SHA1, "sha1" },
+	{ R_HASH_SHA256, R_HASH_SIZE_SHA256, "sha256" },
+};
+
+static const ut8 *hash_do(RHash *h, ut64 algo, const ut8 *buf, int len) {
+	switch (algo) {
+	case R_HASH_MD5: return r_hash_do_md5 (h, buf, len);
+	case R_HASH_SHA1: return r_hash_do_sha1 (h, buf, len);
+	case R_HASH_SHA256: return r_hash_do_sha256 (h, buf, len);
+	}
+	return NULL;
+}
+
+static bool check_digest(ut64 algo, const char *input, const char *expected) {
+	RHash *h = r_hash_new (true, algo);
+	int size = r_hash_calculate (h, algo, (const ut8 *)input, strlen (input));
+	char *hex = r_hex_bin2strdup (h->digest, size);
+	mu_assert_streq (hex, expected, input);
+	free (hex);
+	r_hash_free (h);
+	return true;
+}
+
+bool test_r_hash_vectors(void) {
+	mu_assert ("md5 empty", check_digest (R_HASH_MD5, "", "d41d8cd98f00b204e9800998ecf8427e"));
+	mu_assert ("md5 abc", check_digest (R_HASH_MD5, "abc", "900150983cd24fb0d6963f7d28e17f72"));
+	mu_assert ("md5 fox", check_digest (R_HASH_MD5, "The quick brown fox jumps over the lazy dog",
+		"9e107d9d372bb6826bd81d3542a419d6"));
+	mu_assert ("sha1 empty", check_digest (R_HASH_SHA1, "", "da39a3ee5e6b4b0d3255bfef95601890afd80709"));
+	mu_assert ("sha1 abc", check_digest (R_HASH_SHA1, "abc", "a9993e364706816aba3e25717850c26c9cd0d89d"));
+	mu_assert ("sha256 empty", check_digest (R_HASH_SHA256, "",
+		"e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"));
+	mu_assert ("sha256 abc", check_digest (R_HASH_SHA256, "abc",
+		"ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"));
+	mu_assert ("sha256 two blocks", check_digest (R_HASH_SHA256,
+		"abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+		"248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"));
+	mu_end;
+}
+
+// feeding md5, sha1 and sha256 the same chunks in a single pass over the
+// input gives the same digests as hashing it once per algorithm
+bool test_r_hash_single_pass(void) {
+	static const int chunks[] = { 1, 3, 55, 56, 63, 64, 65, 128, 1000, 4096 };
+	const int len = 4096 + 17;
+	ut8 *buf = malloc (len);
+	ut8 expected[R_ARRAY_SIZE (algos)][R_HASH_SIZE_SHA256];
+	int i, j, c, off;
+	for (i = 0; i < len; i++) {
+		buf[i] = (i * 7) ^ (i >> 5);
+	}
+	for (j = 0; j < R_ARRAY_SIZE (algos); j++) {
+		RHash *h = r_hash_new (true, algos[j].algo);
+		memcpy (expected[j], hash_do (h, algos[j].algo, buf, len), algos[j].size);
+		r_hash_free (h);
+	}
+	for (c = 0; c < R_ARRAY_SIZE (chunks); c++) {
+		RHash *h = r_hash_new (false, R_HASH_MD5 | R_HASH_SHA1 | R_HASH_SHA256);
+		r_hash_do_begin (h, R_HASH_MD5 | R_HASH_SHA1 | R_HASH_SHA256);
+		for (off = 0; off < len; off += chunks[c]) {
+			for (j = 0; j < R_ARRAY_SIZE (algos); j++) {
+				hash_do (h, algos[j].algo, buf + off, R_MIN (chunks[c], len - off));
+			}
+		}
+		// every digest is written to h->digest, so finalize them one by one
+		for (j = 0; j < R_ARRAY_SIZE (algos); j++) {
+			r_hash_do_end (h, algos[j].algo);
+			mu_assert_memeq (h->digest, expected[j], algos[j].size, algos[j].name);
+		}
+		r_hash_free (h);
+	}
+	free (buf);
+	mu_end;
+}
+
+// the same context can hash several inputs in a row when reset is enabled
+bool test_r_hash_reset(void) {
+	RHash *h = r_hash_new (true, R_HASH_MD5);
+	char *hex;
+	r_hash_do_md5 (h, (const ut8 *)"hello", 5);
+	r_hash_do_md5 (h, (const ut8 *)"abc", 3);
+	hex = r_hex_bin2strdup (h->digest, R_HASH_SIZE_MD5);
+	mu_assert_streq (hex, "900150983cd24fb0d6963f7d28e17f72", "md5 after reset");
+	free (hex);
+	r_hash_free (h);
+	mu_end;
+}
+
+int all_tests() {
+	mu_run_test (test_r_hash_vectors);
+	mu_run_test (test_r_hash_single_pass);
+	mu_run_test (test_r_hash_reset);
+	return tests_passed != tests_run;
+}
+
+int main(int argc, char **argv) {
+	return all_tests();
+}
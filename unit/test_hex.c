@@ -88,11 +88,115 @@ bool test_r_hex_no_code() {
 	mu_end;
 }
 
+bool test_r_hex_bin2str_roundtrip() {
+	ut8 bin[256], back[256];
+	char str[513];
+	int i;
+	for (i = 0; i < 256; i++) {
+		bin[i] = i;
+	}
+	mu_assert_eq (r_hex_bin2str (bin, 256, str), 256, "bin2str length");
+	mu_assert_eq ((int)strlen (str), 512, "two lowercase digits per byte");
+	mu_assert ("starts with 000102", !strncmp (str, "000102", 6));
+	mu_assert_streq (str + 500, "fafbfcfdfeff", "ends with fafbfcfdfeff");
+	mu_assert_eq (r_hex_str2bin (str, back), 256, "str2bin length");
+	mu_assert_memeq (back, bin, 256, "roundtrip");
+	// every length from 0 to 256 and every offset of the input buffer
+	for (i = 0; i <= 256; i++) {
+		int off = i % 16, len = R_MIN (i, 256 - off);
+		memset (back, 0, sizeof (back));
+		r_hex_bin2str (bin + off, len, str);
+		mu_assert_eq ((int)strlen (str), len * 2, "bin2str terminates the string");
+		mu_assert_eq (r_hex_str2bin (str, back), len, "str2bin length");
+		mu_assert_memeq (back, bin + off, len, "roundtrip");
+	}
+	mu_end;
+}
+
+// every pair of hex digits in either case decodes to the same byte
+bool test_r_hex_str2bin_digits() {
+	const char *digits = "0123456789abcdefABCDEF";
+	char msg[32], str[3] = {0};
+	int i, j;
+	for (i = 0; digits[i]; i++) {
+		for (j = 0; digits[j]; j++) {
+			ut8 out = 0, expected;
+			str[0] = digits[i];
+			str[1] = digits[j];
+			expected = strtoul (str, NULL, 16);
+			snprintf (msg, sizeof (msg), "decode %s", str);
+			mu_assert_eq (r_hex_str2bin (str, &out), 1, msg);
+			mu_assert_eq (out, expected, msg);
+		}
+	}
+	mu_end;
+}
+
+// any byte that is not a hex digit, whitespace or the start of a comment
+// makes the whole string invalid
+bool test_r_hex_str2bin_invalid() {
+	char msg[32], str[6] = "41?42";
+	ut8 out[4];
+	int c;
+	for (c = 1; c < 256; c++) {
+		if (isxdigit (c) || isspace (c) || c == '#' || c == '/') {
+			continue;
+		}
+		str[2] = c;
+		snprintf (msg, sizeof (msg), "invalid nibble 0x%02x", c);
+		mu_assert_eq (r_hex_str2bin (str, out), 0, msg);
+	}
+	mu_end;
+}
+
+bool test_r_hex_str2bin_odd() {
+	ut8 out[4] = {0};
+	ut8 one[] = { 0x10 };
+	ut8 three[] = { 0x12, 0x30 };
+	// odd nibble counts return the negated length, padding the last nibble
+	mu_assert_eq (r_hex_str2bin ("1", out), -1, "one nibble");
+	mu_assert_memeq (out, one, 1, "one nibble is the high half");
+	mu_assert_eq (r_hex_str2bin ("123", out), -2, "three nibbles");
+	mu_assert_memeq (out, three, 2, "three nibbles");
+	mu_assert_eq (r_hex_str2bin ("1 2 3", out), -2, "three spaced nibbles");
+	mu_assert_memeq (out, three, 2, "three spaced nibbles");
+	mu_assert_eq (r_hex_str2bin ("", out), 0, "empty string");
+	mu_end;
+}
+
+bool test_r_hex_str2bin_whitespace() {
+	ut8 expected[] = { 0x41, 0x42, 0x43, 0x44 };
+	ut8 out[4];
+	static const char *strs[] = {
+		"41424344",
+		"41 42 43 44",
+		"  41\t42\n43 44  ",
+		"4 1 4 2 4 3 4 4",
+		"0x41424344",
+		"41424344 # comment",
+		"4142 // comment\n4344",
+	};
+	int i;
+	for (i = 0; i < R_ARRAY_SIZE (strs); i++) {
+		memset (out, 0, sizeof (out));
+		mu_assert_eq (r_hex_str2bin (strs[i], out), 4, strs[i]);
+		mu_assert_memeq (out, expected, 4, strs[i]);
+	}
+	// the length can be asked for without an output buffer
+	mu_assert_eq (r_hex_str2bin ("41 42 43 44", NULL), 4, "NULL output");
+	mu_end;
+}
+
 bool all_tests() {
 	mu_run_test (test_r_hex_from_c);
 	mu_run_test (test_r_hex_from_py);
 	mu_run_test (test_r_hex_from_code);
 	mu_run_test (test_r_hex_no_code);
+	mu_run_test (test_r_hex_bin2str_roundtrip);
+	mu_run_test (test_r_hex_str2bin_digits);
+	mu_run_test (test_r_hex_str2bin_invalid);
+	mu_run_test (test_r_hex_str2bin_odd);
+	mu_run_test (test_r_hex_str2bin_whitespace);
 	return tests_passed != tests_run;
 }
 
@@ -0,0 +1,225 @@
+#include <r_util.h>
+#include <sdb.h>
+#include "minunit.h"
+
+// Behaviour any hashtable backing flags, symbols and xrefs has to keep,
+// whatever its collision strategy (chaining or open addressing).
+
+static bool count_cb(void *user, const char *k, void *v) {
+	int *count = user;
+	(*count)++;
+	return true;
+}
+
+static bool mark_cb(void *user, const char *k, void *v) {
+	ut8 *seen = user;
+	seen[(int)(size_t)v]++;
+	return true;
+}
+
+bool test_ht_insert_find(void) {
+	SdbHash *ht = ht_new (NULL, NULL, NULL);
+	char key[32];
+	bool found;
+	int i;
+	for (i = 0; i < 1000; i++) {
+		snprintf (key, sizeof (key), "sym.func.%d", i);
+		mu_assert ("insert", ht_insert (ht, key, (void *)(size_t)i));
+	}
+	mu_assert_eq (ht->count, 1000, "count after insert");
+	for (i = 0; i < 1000; i++) {
+		snprintf (key, sizeof (key), "sym.func.%d", i);
+		mu_assert_eq ((int)(size_t)ht_find (ht, key, &found), i, "find value");
+		mu_assert ("find found", found);
+	}
+	ht_find (ht, "sym.func.1000", &found);
+	mu_assert ("missing key", !found);
+	ht_find (ht, "sym.func.", &found);
+	mu_assert ("prefix of a key", !found);
+
+	mu_assert ("insert existing key fails", !ht_insert (ht, "sym.func.42", (void *)1337));
+	mu_assert_eq ((int)(size_t)ht_find (ht, "sym.func.42", NULL), 42, "value kept");
+	mu_assert ("update existing key", ht_update (ht, "sym.func.42", (void *)1337));
+	mu_assert_eq ((int)(size_t)ht_find (ht, "sym.func.42", NULL), 1337, "value updated");
+	mu_assert_eq (ht->count, 1000, "count after update");
+	ht_free (ht);
+	mu_end;
+}
+
+bool test_ht_delete_reinsert(void) {
+	SdbHash *ht = ht_new (NULL, NULL, NULL);
+	char key[32];
+	bool found;
+	int i;
+	for (i = 0; i < 4096; i++) {
+		snprintf (key, sizeof (key), "k%d", i);
+		ht_insert (ht, key, (void *)(size_t)i);
+	}
+	// deleted slots must not hide the keys inserted after them
+	for (i = 0; i < 4096; i += 2) {
+		snprintf (key, sizeof (key), "k%d", i);
+		mu_assert ("delete", ht_delete (ht, key));
+		mu_assert ("delete twice", !ht_delete (ht, key));
+	}
+	mu_assert_eq (ht->count, 2048, "count after delete");
+	for (i = 0; i < 4096; i++) {
+		snprintf (key, sizeof (key), "k%d", i);
+		ht_find (ht, key, &found);
+		mu_assert_eq (found, (i & 1) == 1, "find after delete");
+	}
+	for (i = 0; i < 4096; i += 2) {
+		snprintf (key, sizeof (key), "k%d", i);
+		mu_assert ("reinsert", ht_insert (ht, key, (void *)(size_t)(i + 1)));
+	}
+	mu_assert_eq (ht->count, 4096, "count after reinsert");
+	for (i = 0; i < 4096; i++) {
+		snprintf (key, sizeof (key), "k%d", i);
+		mu_assert_eq ((int)(size_t)ht_find (ht, key, &found), i | 1, "value after reinsert");
+		mu_assert ("found after reinsert", found);
+	}
+	ht_free (ht);
+	mu_end;
+}
+
+bool test_ht_grow(void) {
+	SdbHash *ht = ht_new (NULL, NULL, NULL);
+	ut32 size = ht->size;
+	char key[32];
+	bool found;
+	int i;
+	for (i = 0; i < 200000; i++) {
+		snprintf (key, sizeof (key), "str.%x", i);
+		ht_insert (ht, key, (void *)(size_t)i);
+	}
+	mu_assert ("table grew", ht->size > size);
+	mu_assert_eq (ht->count, 200000, "count after grow");
+	for (i = 0; i < 200000; i++) {
+		snprintf (key, sizeof (key), "str.%x", i);
+		mu_assert_eq ((int)(size_t)ht_find (ht, key, &found), i, "find after grow");
+		mu_assert ("found after grow", found);
+	}
+	ht_free (ht);
+	mu_end;
+}
+
+bool test_ht_foreach(void) {
+	SdbHash *a = ht_new (NULL, NULL, NULL);
+	SdbHash *b = ht_new (NULL, NULL, NULL);
+	ut8 seen_a[1000] = {0}, seen_b[1000] = {0};
+	char key[32];
+	int i, count = 0;
+	// same set in opposite order, with deletions in between
+	for (i = 0; i < 1000; i++) {
+		snprintf (key, sizeof (key), "f%d", i);
+		ht_insert (a, key, (void *)(size_t)i);
+		snprintf (key, sizeof (key), "f%d", 999 - i);
+		ht_insert (b, key, (void *)(size_t)(999 - i));
+		snprintf (key, sizeof (key), "tmp%d", i);
+		ht_insert (b, key, NULL);
+		ht_delete (b, key);
+	}
+	ht_foreach (a, count_cb, &count);
+	mu_assert_eq (count, 1000, "foreach visits every element");
+	ht_foreach (a, mark_cb, seen_a);
+	ht_foreach (b, mark_cb, seen_b);
+	for (i = 0; i < 1000; i++) {
+		mu_assert_eq (seen_a[i], 1, "each element visited once");
+	}
+	mu_assert ("same elements regardless of insertion order", !memcmp (seen_a, seen_b, sizeof (seen_a)));
+	ht_free (a);
+	ht_free (b);
+	mu_end;
+}
+
+// ut64 keys stored in the key pointer itself, as for tables indexed by
+// address: no key copy, the hash and the comparison work on the value.
+// 0 is left out, a NULL key is not a valid key.
+static ut32 u64_hash(const char *k) {
+	ut64 v = (ut64)(size_t)k;
+	return (ut32)(v ^ (v >> 32));
+}
+
+static int u64_cmp(const char *a, const char *b) {
+	return a != b;
+}
+
+static SdbHash *ht_new_u64(void) {
+	SdbHash *ht = ht_new (NULL, NULL, NULL);
+	ht->hashfn = u64_hash;
+	ht->cmp = u64_cmp;
+	ht->dupkey = NULL;
+	ht->calcsizeK = NULL;
+	return ht;
+}
+
+bool test_ht_u64_raw_keys(void) {
+	static const ut64 addrs[] = {
+		1, 0x400000, 0x7fffffff, 0x80000000, 0xffffffff,
+		0x100000000ULL, 0x100000001ULL, 0x7fffffffffffffffULL, UT64_MAX - 1, UT64_MAX
+	};
+	SdbHash *ht;
+	bool found;
+	int i;
+	if (sizeof (void *) < sizeof (ut64)) {
+		mu_end;
+	}
+	ht = ht_new_u64 ();
+	for (i = 0; i < R_ARRAY_SIZE (addrs); i++) {
+		mu_assert ("insert addr", ht_insert (ht, (const char *)(size_t)addrs[i], (void *)(size_t)(i + 1)));
+	}
+	// 0xffffffff and 0x100000001 differ only in the upper half of the hash input
+	for (i = 0; i < R_ARRAY_SIZE (addrs); i++) {
+		mu_assert_eq ((int)(size_t)ht_find (ht, (const char *)(size_t)addrs[i], &found), i + 1, "find addr");
+		mu_assert ("found addr", found);
+	}
+	ht_find (ht, (const char *)(size_t)0x400001, &found);
+	mu_assert ("missing addr", !found);
+	mu_assert ("delete addr", ht_delete (ht, (const char *)(size_t)0x80000000));
+	ht_find (ht, (const char *)(size_t)0x80000000, &found);
+	mu_assert ("deleted addr", !found);
+	// dense addresses, as basic blocks of a function
+	for (i = 0; i < 100000; i++) {
+		ht_insert (ht, (const char *)(size_t)(0x1000000 + i * 4), (void *)(size_t)i);
+	}
+	for (i = 0; i < 100000; i++) {
+		mu_assert_eq ((int)(size_t)ht_find (ht, (const char *)(size_t)(0x1000000 + i * 4), &found), i, "find dense addr");
+		mu_assert ("found dense addr", found);
+	}
+	ht_free (ht);
+	mu_end;
+}
+
+bool test_ht_u64_keys(void) {
+	static const ut64 addrs[] = {
+		0, 1, 0x400000, 0x7fffffff, 0x80000000, 0xffffffff,
+		0x100000000ULL, 0x7fffffffffffffffULL, UT64_MAX - 1, UT64_MAX
+	};
+	SdbHash *ht = ht_new (NULL, NULL, NULL);
+	char key[32];
+	bool found;
+	int i;
+	for (i = 0; i < R_ARRAY_SIZE (addrs); i++) {
+		snprintf (key, sizeof (key), "0x%"PFMT64x, addrs[i]);
+		mu_assert ("insert addr", ht_insert (ht, key, (void *)(size_t)(i + 1)));
+	}
+	for (i = 0; i < R_ARRAY_SIZE (addrs); i++) {
+		snprintf (key, sizeof (key), "0x%"PFMT64x, addrs[i]);
+		mu_assert_eq ((int)(size_t)ht_find (ht, key, &found), i + 1, "find addr");
+	}
+	ht_free (ht);
+	mu_end;
+}
+
+int all_tests() {
+	mu_run_test (test_ht_insert_find);
+	mu_run_test (test_ht_delete_reinsert);
+	mu_run_test (test_ht_grow);
+	mu_run_test (test_ht_foreach);
+	mu_run_test (test_ht_u64_keys);
+	mu_run_test (test_ht_u64_raw_keys);
+	return tests_passed != tests_run;
+}
+
+int main(int argc, char **argv) {
+	return all_tests();
+}
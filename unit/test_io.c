@@ -130,6 +130,101 @@ bool test_r_io_priority(void) {
 	mu_end;
 }
 
+#define NMAPS 4096
+#define MAPSPACE 0x100000
+#define FDSIZE 0x10000
+
+typedef struct {
+	ut32 id;
+	ut64 from, size, delta;
+} MapOracle;
+
+// the newest map containing addr wins
+static const MapOracle *oracle_map_get(const MapOracle *maps, int n, ut64 addr) {
+	int i;
+	for (i = n - 1; i >= 0; i--) {
+		if (addr >= maps[i].from && addr - maps[i].from < maps[i].size) {
+			return &maps[i];
+		}
+	}
+	return NULL;
+}
+
+bool test_r_io_map_get_overlapping(void) {
+	RIO *io = r_io_new ();
+	MapOracle *maps = calloc (NMAPS, sizeof (MapOracle));
+	ut8 *data = malloc (FDSIZE);
+	int fd, i;
+	srand (1337);
+	io->va = true;
+	fd = r_io_fd_open (io, "malloc://65536", R_IO_RW, 0);
+	for (i = 0; i < FDSIZE; i++) {
+		data[i] = (i & 0xff) ^ (i >> 8);
+	}
+	r_io_fd_write_at (io, fd, 0, data, FDSIZE);
+	for (i = 0; i < NMAPS; i++) {
+		RIOMap *map;
+		maps[i].size = 1 + rand () % 0x2000;
+		maps[i].from = rand () % (MAPSPACE - maps[i].size);
+		maps[i].delta = rand () % (FDSIZE - maps[i].size);
+		map = r_io_map_add (io, fd, R_IO_READ, maps[i].delta, maps[i].from, maps[i].size, false);
+		mu_assert ("map added", map);
+		maps[i].id = map->id;
+	}
+	r_io_map_calculate_skyline (io);
+	for (i = 0; i < 20000; i++) {
+		ut64 addr = rand () % (MAPSPACE + 0x100);
+		const MapOracle *m = oracle_map_get (maps, NMAPS, addr);
+		RIOMap *map = r_io_map_get (io, addr);
+		ut8 b;
+		if (!m) {
+			mu_assert ("no map expected", !map);
+			continue;
+		}
+		mu_assert ("map expected", map);
+		mu_assert_eq (map->id, m->id, "topmost map");
+		r_io_read_at (io, addr, &b, 1);
+		mu_assert_eq (b, data[m->delta + addr - m->from], "read through topmost map");
+	}
+	r_io_free (io);
+	free (maps);
+	free (data);
+	mu_end;
+}
+
+// the first and last byte of every map, where most off by ones hide
+bool test_r_io_map_get_edges(void) {
+	RIO *io = r_io_new ();
+	MapOracle *maps = calloc (NMAPS, sizeof (MapOracle));
+	int fd, i, j;
+	srand (1337);
+	io->va = true;
+	fd = r_io_fd_open (io, "malloc://65536", R_IO_RW, 0);
+	for (i = 0; i < NMAPS; i++) {
+		RIOMap *map;
+		maps[i].size = 1 + rand () % 0x200;
+		maps[i].from = rand () % (MAPSPACE - maps[i].size);
+		map = r_io_map_add (io, fd, R_IO_READ, 0, maps[i].from, maps[i].size, false);
+		mu_assert ("map added", map);
+		maps[i].id = map->id;
+	}
+	r_io_map_calculate_skyline (io);
+	for (i = 0; i < NMAPS; i++) {
+		const ut64 addrs[] = {
+			maps[i].from - 1, maps[i].from,
+			maps[i].from + maps[i].size - 1, maps[i].from + maps[i].size
+		};
+		for (j = 0; j < R_ARRAY_SIZE (addrs); j++) {
+			const MapOracle *m = oracle_map_get (maps, NMAPS, addrs[j]);
+			RIOMap *map = r_io_map_get (io, addrs[j]);
+			mu_assert_eq (map? map->id: 0, m? m->id: 0, "map at edge");
+		}
+	}
+	r_io_free (io);
+	free (maps);
+	mu_end;
+}
+
 int all_tests() {
 	mu_run_test(test_r_io_mapsplit);
 	mu_run_test(test_r_io_mapsplit2);
@@ -137,6 +232,8 @@ int all_tests() {
 	mu_run_test(test_r_io_desc_exchange);
 	// mu_run_test(test_r_io_priority);
 	mu_run_test(test_va_malloc_zero);
+	mu_run_test(test_r_io_map_get_overlapping);
+	mu_run_test(test_r_io_map_get_edges);
 	return tests_passed != tests_run;
 }
 
@@ -299,6 +299,91 @@ bool test_r_list_sort4(void) {
 	mu_end;
 }
 
+typedef struct {
+	int key;
+	int seq;
+} SortItem;
+
+static int cmp_item_key(const void *a, const void *b) {
+	return ((const SortItem *)a)->key - ((const SortItem *)b)->key;
+}
+
+static int cmp_item(const void *a, const void *b) {
+	const SortItem *x = a, *y = b;
+	return x->key != y->key? x->key - y->key: x->seq - y->seq;
+}
+
+// sorts n random items with few distinct keys and checks the result against qsort on (key, seq)
+static bool check_merge_sort(int n, int nkeys) {
+	SortItem *items = calloc (n, sizeof (SortItem));
+	SortItem *expected = calloc (n, sizeof (SortItem));
+	RList *list = r_list_new ();
+	RListIter *iter;
+	SortItem *item;
+	int i;
+	for (i = 0; i < n; i++) {
+		items[i].key = rand () % nkeys;
+		items[i].seq = i;
+		r_list_append (list, &items[i]);
+	}
+	memcpy (expected, items, n * sizeof (SortItem));
+	qsort (expected, n, sizeof (SortItem), cmp_item);
+	r_list_merge_sort (list, (RListComparator)cmp_item_key);
+	mu_assert_eq (r_list_length (list), n, "sorted list length");
+	i = 0;
+	r_list_foreach (list, iter, item) {
+		mu_assert_eq (item->key, expected[i].key, "sorted key");
+		mu_assert_eq (item->seq, expected[i].seq, "equal keys keep their order");
+		i++;
+	}
+	r_list_free (list);
+	free (expected);
+	free (items);
+	return true;
+}
+
+bool test_r_list_merge_sort_stable(void) {
+	int sizes[] = { 1, 2, 3, 43, 44, 1000, 65537 };
+	int i;
+	srand (1337);
+	for (i = 0; i < R_ARRAY_SIZE (sizes); i++) {
+		mu_assert ("stable with duplicates", check_merge_sort (sizes[i], 16));
+		mu_assert ("stable with distinct keys", check_merge_sort (sizes[i], 1 << 30));
+	}
+	mu_end;
+}
+
+// r_list_sort switches algorithm with the list length, the result must not change
+bool test_r_list_sort_random(void) {
+	int sizes[] = { 2, 42, 43, 44, 5000 };
+	int i, j;
+	srand (1337);
+	for (i = 0; i < R_ARRAY_SIZE (sizes); i++) {
+		int *values = calloc (sizes[i], sizeof (int));
+		int *expected = calloc (sizes[i], sizeof (int));
+		RList *list = r_list_new ();
+		RListIter *iter;
+		int *v;
+		for (j = 0; j < sizes[i]; j++) {
+			values[j] = rand () % 1000;
+			r_list_append (list, &values[j]);
+		}
+		r_list_sort (list, (RListComparator)cmp_range);
+		mu_assert_eq (r_list_length (list), sizes[i], "sorted list length");
+		memcpy (expected, values, sizes[i] * sizeof (int));
+		qsort (expected, sizes[i], sizeof (int), cmp_range);
+		j = 0;
+		r_list_foreach (list, iter, v) {
+			mu_assert_eq (*v, expected[j], "same result as qsort");
+			j++;
+		}
+		r_list_free (list);
+		free (expected);
+		free (values);
+	}
+	mu_end;
+}
+
 int all_tests() {
 	mu_run_test(test_r_list_size);
 	mu_run_test(test_r_list_values);
@@ -310,6 +395,8 @@ int all_tests() {
 	mu_run_test(test_r_list_sort3);
 	mu_run_test(test_r_list_sort4);
 	mu_run_test(test_r_list_sort5);
+	mu_run_test(test_r_list_merge_sort_stable);
+	mu_run_test(test_r_list_sort_random);
 	mu_run_test(test_r_list_length);
 	return tests_passed != tests_run;
 }
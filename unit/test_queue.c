@@ -1,4 +1,5 @@
 #include <r_util.h>
+#include <r_th.h>
 #include "minunit.h"
 
 bool test_r_queue_add_remove(void) {
@@ -31,9 +32,131 @@ bool test_r_queue_zero_size(void) {
 	mu_end;
 }
 
+// head and tail wrap around the ring many times, growing while wrapped
+bool test_r_queue_wrap(void) {
+	RQueue *queue = r_queue_new (4);
+	int i, next_in = 1, next_out = 1;
+	for (i = 0; i < 1000; i++) {
+		int j, in = 1 + i % 7, out = 1 + (i * 3) % 7;
+		for (j = 0; j < in; j++) {
+			mu_assert ("enqueue", r_queue_enqueue (queue, (void *)(intptr_t)next_in++));
+		}
+		for (j = 0; j < out && next_out < next_in; j++) {
+			mu_assert_eq ((int)(intptr_t)r_queue_dequeue (queue), next_out++, "fifo order");
+		}
+	}
+	while (next_out < next_in) {
+		mu_assert ("not empty", !r_queue_is_empty (queue));
+		mu_assert_eq ((int)(intptr_t)r_queue_dequeue (queue), next_out++, "fifo order on drain");
+	}
+	mu_assert ("empty after drain", r_queue_is_empty (queue));
+	mu_assert_eq ((int)(intptr_t)r_queue_dequeue (queue), 0, "dequeue from drained queue");
+	r_queue_free (queue);
+	mu_end;
+}
+
+#define PRODUCERS 4
+#define CONSUMERS 4
+#define ITEMS 50000
+
+typedef struct {
+	RQueue *queue;
+	RThreadLock *lock;
+	int consumed;
+} SharedQueue;
+
+typedef struct {
+	SharedQueue *sq;
+	int id;
+	int *seen;
+	int last[PRODUCERS];
+	bool ordered;
+} QueueWorker;
+
+static int producer(RThread *th) {
+	QueueWorker *w = th->user;
+	int i;
+	for (i = 0; i < ITEMS; i++) {
+		r_th_lock_enter (w->sq->lock);
+		r_queue_enqueue (w->sq->queue, (void *)(intptr_t)(w->id * ITEMS + i + 1));
+		r_th_lock_leave (w->sq->lock);
+	}
+	return 0;
+}
+
+static int consumer(RThread *th) {
+	QueueWorker *w = th->user;
+	for (;;) {
+		void *item;
+		r_th_lock_enter (w->sq->lock);
+		if (w->sq->consumed == PRODUCERS * ITEMS) {
+			r_th_lock_leave (w->sq->lock);
+			break;
+		}
+		item = r_queue_dequeue (w->sq->queue);
+		if (item) {
+			w->sq->consumed++;
+		}
+		r_th_lock_leave (w->sq->lock);
+		if (item) {
+			int v = (int)(intptr_t)item - 1;
+			// items from the same producer come out in order
+			if (v % ITEMS < w->last[v / ITEMS]) {
+				w->ordered = false;
+			}
+			w->last[v / ITEMS] = v % ITEMS;
+			w->seen[v]++;
+		}
+	}
+	return 0;
+}
+
+bool test_r_queue_threads(void) {
+	SharedQueue sq = { r_queue_new (16), r_th_lock_new (false), 0 };
+	QueueWorker producers[PRODUCERS], consumers[CONSUMERS];
+	RThread *th[PRODUCERS + CONSUMERS];
+	int i, j;
+	for (i = 0; i < CONSUMERS; i++) {
+		consumers[i].sq = &sq;
+		consumers[i].seen = calloc (PRODUCERS * ITEMS, sizeof (int));
+		consumers[i].ordered = true;
+		for (j = 0; j < PRODUCERS; j++) {
+			consumers[i].last[j] = -1;
+		}
+		th[PRODUCERS + i] = r_th_new (consumer, &consumers[i], 0);
+	}
+	for (i = 0; i < PRODUCERS; i++) {
+		producers[i].sq = &sq;
+		producers[i].id = i;
+		th[i] = r_th_new (producer, &producers[i], 0);
+	}
+	for (i = 0; i < PRODUCERS + CONSUMERS; i++) {
+		mu_assert ("thread created", th[i]);
+		r_th_wait (th[i]);
+		r_th_free (th[i]);
+	}
+	for (j = 0; j < PRODUCERS * ITEMS; j++) {
+		int count = 0;
+		for (i = 0; i < CONSUMERS; i++) {
+			count += consumers[i].seen[j];
+		}
+		mu_assert_eq (count, 1, "every item dequeued exactly once");
+	}
+	for (i = 0; i < CONSUMERS; i++) {
+		mu_assert ("per producer order", consumers[i].ordered);
+		free (consumers[i].seen);
+	}
+	mu_assert ("queue drained", r_queue_is_empty (sq.queue));
+	r_th_lock_free (sq.lock);
+	r_queue_free (sq.queue);
+	mu_end;
+}
+
 int all_tests() {
 	mu_run_test(test_r_queue_add_remove);
 	mu_run_test(test_r_queue_zero_size);
+	mu_run_test(test_r_queue_wrap);
+	mu_run_test(test_r_queue_threads);
 	return tests_passed != tests_run;
 }
 
@@ -89,6 +89,85 @@ bool test_r_tinyrange_in_four(void) {
 }
 
 
+static bool oracle_in(const ut64 *ranges, int n, ut64 at) {
+	int i;
+	for (i = 0; i < n; i++) {
+		if (at >= ranges[i * 2] && at < ranges[i * 2 + 1]) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// basic blocks of a big function: sorted, mostly contiguous, some gaps
+bool test_r_tinyrange_in_bbs(void) {
+	RRangeTiny *bbr = r_tinyrange_new ();
+	ut64 ranges[2 * 2048];
+	ut64 at = 0x400000;
+	int i, j;
+	srand (1337);
+	for (i = 0; i < 2048; i++) {
+		at += (rand () % 4)? 0: 1 + rand () % 32;
+		ranges[i * 2] = at;
+		at += 1 + rand () % 64;
+		ranges[i * 2 + 1] = at;
+		r_tinyrange_add (bbr, ranges[i * 2], ranges[i * 2 + 1]);
+	}
+	for (i = 0; i < 2048; i++) {
+		const ut64 from = ranges[i * 2], to = ranges[i * 2 + 1];
+		const ut64 points[] = { from - 1, from, from + 1, to - 1, to, to + 1 };
+		for (j = 0; j < R_ARRAY_SIZE (points); j++) {
+			mu_assert_eq (r_tinyrange_in (bbr, points[j]), oracle_in (ranges, 2048, points[j]), "bb boundary");
+		}
+	}
+	mu_assert_eq (false, r_tinyrange_in (bbr, 0x3fffff), "before first bb");
+	mu_assert_eq (false, r_tinyrange_in (bbr, at), "end of last bb");
+	r_tinyrange_fini (bbr);
+	free (bbr);
+	mu_end;
+}
+
+// r_tinyrange_in expects the ranges in ascending order: random sizes and
+// gaps, stabbed at random addresses
+bool test_r_tinyrange_in_random(void) {
+	RRangeTiny *bbr = r_tinyrange_new ();
+	ut64 ranges[2 * 512];
+	ut64 at = 0x1000;
+	int i;
+	srand (1337);
+	for (i = 0; i < 512; i++) {
+		at += rand () % 0x80;
+		ranges[i * 2] = at;
+		at += 1 + rand () % 0x100;
+		ranges[i * 2 + 1] = at;
+		r_tinyrange_add (bbr, ranges[i * 2], ranges[i * 2 + 1]);
+	}
+	for (i = 0; i < 20000; i++) {
+		ut64 addr = rand () % (at + 0x100);
+		mu_assert_eq (r_tinyrange_in (bbr, addr), oracle_in (ranges, 512, addr), "random stab");
+	}
+	r_tinyrange_fini (bbr);
+	free (bbr);
+	mu_end;
+}
+
+bool test_r_tinyrange_in_high(void) {
+	RRangeTiny *bbr = r_tinyrange_new ();
+	r_tinyrange_add (bbr, 0, 1);
+	r_tinyrange_add (bbr, 0xffffffff, 0x100000001ULL);
+	r_tinyrange_add (bbr, 0xfffffffffffff000ULL, UT64_MAX);
+	mu_assert_eq (true, r_tinyrange_in (bbr, 0), "zero");
+	mu_assert_eq (false, r_tinyrange_in (bbr, 1), "one");
+	mu_assert_eq (true, r_tinyrange_in (bbr, 0xfffffffffffff000ULL), "high from");
+	mu_assert_eq (true, r_tinyrange_in (bbr, UT64_MAX - 1), "high to");
+	mu_assert_eq (false, r_tinyrange_in (bbr, UT64_MAX), "high end");
+	mu_assert_eq (true, r_tinyrange_in (bbr, 0xffffffff), "32bit boundary");
+	mu_assert_eq (true, r_tinyrange_in (bbr, 0x100000000ULL), "across 32bit boundary");
+	mu_assert_eq (false, r_tinyrange_in (bbr, 0x100000001ULL), "after 32bit boundary");
+	r_tinyrange_fini (bbr);
+	free (bbr);
+	mu_end;
+}
 
 int all_tests() {
 	mu_run_test (test_r_tinyrange_in);
@@ -96,6 +175,9 @@ int all_tests() {
 	mu_run_test (test_r_tinyrange_in_two);
 	mu_run_test (test_r_tinyrange_in_three);
 	mu_run_test (test_r_tinyrange_in_four);
+	mu_run_test (test_r_tinyrange_in_bbs);
+	mu_run_test (test_r_tinyrange_in_random);
+	mu_run_test (test_r_tinyrange_in_high);
 	return tests_passed != tests_run;
 }
 
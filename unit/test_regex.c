@@ -0,0 +1,83 @@
+#include <r_util.h>
+#include "minunit.h"
+
+// POSIX extended regex conformance: leftmost match, longest among the
+// alternatives, as any replacement engine (DFA or otherwise) must report
+
+typedef struct {
+	const char *pattern;
+	const char *flags;
+	const char *text;
+	int so, eo; // -1 when there is no match
+} RegexCase;
+
+static const RegexCase cases[] = {
+	{ "abc", "e", "abcd", 0, 3 },
+	{ "b+", "e", "abbbc", 1, 4 },
+	{ "a|ab|abc", "e", "abcd", 0, 3 },
+	{ "(a|b)*c", "e", "abac", 0, 4 },
+	{ "(ab)+", "e", "xababab", 1, 7 },
+	{ "a{2,3}", "e", "aaaa", 0, 3 },
+	{ "x*", "e", "abc", 0, 0 },
+	{ "^foo", "e", "xfoo", -1, -1 },
+	{ "foo$", "e", "xfoo", 1, 4 },
+	{ "[0-9]+", "e", "abc123def", 3, 6 },
+	{ "[^a]", "e", "aab", 2, 3 },
+	{ "[[:alpha:]]+", "e", "12ab34", 2, 4 },
+	{ "[[:xdigit:]]{4}", "e", "zz00fFg", 2, 6 },
+	{ "\\.", "e", "a.b", 1, 2 },
+	{ "a.c", "e", "a\nc", 0, 3 },
+	{ "E.F", "ei", "xxelf", 2, 5 },
+	{ "test", "ei", "a TeSt", 2, 6 },
+	{ "test", "e", "a TeSt", -1, -1 },
+	{ "(foo|bar)baz", "e", "foobarbaz", 3, 9 },
+	{ "ELF", "e", "\x7f" "ELF\x02\x01", 1, 4 },
+	// exponential for naive backtracking, linear for an automaton
+	{ "a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?a?aaaaaaaaaaaaaaaaaaaa", "e", "aaaaaaaaaaaaaaaaaaaa", 0, 20 },
+	{ "(a*)*b", "e", "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaac", -1, -1 },
+	{ "(x+x+)+y", "e", "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx", -1, -1 },
+};
+
+bool test_r_regex_conformance(void) {
+	char msg[256];
+	int i;
+	for (i = 0; i < R_ARRAY_SIZE (cases); i++) {
+		const RegexCase *c = &cases[i];
+		RRegexMatch m[1];
+		RRegex *rx = r_regex_new (c->pattern, c->flags);
+		int ret;
+		snprintf (msg, sizeof (msg), "compile /%s/%s", c->pattern, c->flags);
+		mu_assert (msg, rx);
+		ret = r_regex_exec (rx, c->text, 1, m, 0);
+		snprintf (msg, sizeof (msg), "/%s/%s match", c->pattern, c->flags);
+		mu_assert_eq (ret == 0, c->so != -1, msg);
+		if (!ret) {
+			snprintf (msg, sizeof (msg), "/%s/%s start", c->pattern, c->flags);
+			mu_assert_eq ((int)m[0].rm_so, c->so, msg);
+			snprintf (msg, sizeof (msg), "/%s/%s end", c->pattern, c->flags);
+			mu_assert_eq ((int)m[0].rm_eo, c->eo, msg);
+		}
+		r_regex_free (rx);
+	}
+	mu_end;
+}
+
+bool test_r_regex_invalid(void) {
+	static const char *invalid[] = { "(", "a**", "[a", "a{2,1}", "\\" };
+	int i;
+	for (i = 0; i < R_ARRAY_SIZE (invalid); i++) {
+		RRegex *rx = r_regex_new (invalid[i], "e");
+		mu_assert ("invalid pattern does not compile", !rx);
+	}
+	mu_end;
+}
+
+int all_tests() {
+	mu_run_test (test_r_regex_conformance);
+	mu_run_test (test_r_regex_invalid);
+	return tests_passed != tests_run;
+}
+
+int main(int argc, char **argv) {
+	return all_tests();
+}
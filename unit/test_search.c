@@ -0,0 +1,228 @@
+#include <r_search.h>
+#include "minunit.h"
+
+#define MAX_HITS 1024
+
+typedef struct {
+	RSearchKeyword *kws[64];
+	int nkws;
+	int kw[MAX_HITS];
+	ut64 addr[MAX_HITS];
+	int count;
+} Hits;
+
+static int hit(RSearchKeyword *kw, void *user, ut64 addr) {
+	Hits *hits = user;
+	int i;
+	if (hits->count < MAX_HITS) {
+		hits->kw[hits->count] = -1;
+		for (i = 0; i < hits->nkws; i++) {
+			if (hits->kws[i] == kw) {
+				hits->kw[hits->count] = i;
+			}
+		}
+		hits->addr[hits->count++] = addr;
+	}
+	return 1;
+}
+
+// keywords are matched independently, so hits are not necessarily reported in address order
+static void sort_hits(Hits *hits) {
+	int i, j;
+	for (i = 1; i < hits->count; i++) {
+		for (j = i; j > 0 && hits->addr[j - 1] > hits->addr[j]; j--) {
+			ut64 addr = hits->addr[j];
+			int kw = hits->kw[j];
+			hits->addr[j] = hits->addr[j - 1];
+			hits->kw[j] = hits->kw[j - 1];
+			hits->addr[j - 1] = addr;
+			hits->kw[j - 1] = kw;
+		}
+	}
+}
+
+static RSearch *search_new(int mode, Hits *hits) {
+	RSearch *rs = r_search_new (mode);
+	memset (hits, 0, sizeof (Hits));
+	r_search_set_callback (rs, &hit, hits);
+	return rs;
+}
+
+static void add_kw(RSearch *rs, Hits *hits, RSearchKeyword *kw) {
+	hits->kws[hits->nkws++] = kw;
+	r_search_kw_add (rs, kw);
+}
+
+static const char *buffer = "helloworldlibisnlizbiceandcoolib2loblubljb";
+
+bool test_r_search_keyword(void) {
+	Hits hits;
+	RSearch *rs = search_new (R_SEARCH_KEYWORD, &hits);
+	add_kw (rs, &hits, r_search_keyword_new_str ("lib", "", NULL, 0));
+	r_search_set_distance (rs, 0);
+	r_search_begin (rs);
+	r_search_update_i (rs, 0LL, (const ut8 *)buffer, strlen (buffer));
+	mu_assert_eq (hits.count, 2, "lib hits");
+	mu_assert_eq ((int)hits.addr[0], 10, "first lib");
+	mu_assert_eq ((int)hits.addr[1], 29, "second lib");
+	mu_assert_eq (hits.kws[0]->count, 2, "keyword hit count");
+	r_search_free (rs);
+	mu_end;
+}
+
+// with a distance, "lib" also matches the near misses (lob, lub, ljb, ...)
+// but still reports both exact hits, and going back to 0 is exact again
+bool test_r_search_distance(void) {
+	const int len = strlen (buffer);
+	bool exact10 = false, exact29 = false;
+	Hits hits;
+	int i;
+	RSearch *rs = search_new (R_SEARCH_KEYWORD, &hits);
+	add_kw (rs, &hits, r_search_keyword_new_str ("lib", "", NULL, 0));
+	r_search_set_distance (rs, 4);
+	mu_assert_eq (rs->distance, 4, "distance set");
+	r_search_begin (rs);
+	r_search_update_i (rs, 0LL, (const ut8 *)buffer, len);
+	sort_hits (&hits);
+	mu_assert ("near misses found", hits.count > 2);
+	for (i = 0; i < hits.count; i++) {
+		mu_assert ("hit inside the buffer", hits.addr[i] + 3 <= len);
+		exact10 |= hits.addr[i] == 10;
+		exact29 |= hits.addr[i] == 29;
+	}
+	mu_assert ("exact hit at 10", exact10);
+	mu_assert ("exact hit at 29", exact29);
+
+	hits.count = 0;
+	r_search_set_distance (rs, 0);
+	r_search_begin (rs);
+	r_search_update_i (rs, 0LL, (const ut8 *)buffer, len);
+	mu_assert_eq (hits.count, 2, "lib hits without distance");
+	mu_assert_eq ((int)hits.addr[0], 10, "first lib");
+	mu_assert_eq ((int)hits.addr[1], 29, "second lib");
+	r_search_free (rs);
+	mu_end;
+}
+
+bool test_r_search_binmask(void) {
+	static const int expected[] = { 10, 29, 33, 36, 39 };
+	RSearchKeyword *kw;
+	Hits hits;
+	int i;
+	RSearch *rs = search_new (R_SEARCH_KEYWORD, &hits);
+	kw = r_search_keyword_new_str ("lib", "ff00ff", NULL, 0);
+	mu_assert_memeq (kw->bin_binmask, (ut8 *)"\xff\x00\xff", 3, "binmask");
+	add_kw (rs, &hits, kw);
+	r_search_begin (rs);
+	r_search_update_i (rs, 0LL, (const ut8 *)buffer, strlen (buffer));
+	mu_assert_eq (hits.count, (int)R_ARRAY_SIZE (expected), "l?b hits");
+	for (i = 0; i < R_ARRAY_SIZE (expected); i++) {
+		mu_assert_eq ((int)hits.addr[i], expected[i], "l?b hit address");
+	}
+	r_search_free (rs);
+	mu_end;
+}
+
+// many keywords planted in random data, each starting with a byte that only appears at its hits
+bool test_r_search_many_keywords(void) {
+	const int size = 1 << 16;
+	ut8 *buf = malloc (size);
+	ut8 kwbuf[64][8];
+	int planted[MAX_HITS];
+	int planted_kw[MAX_HITS];
+	int nplanted = 0, i, j;
+	Hits hits;
+	RSearch *rs = search_new (R_SEARCH_KEYWORD, &hits);
+	srand (1337);
+	for (i = 0; i < size; i++) {
+		buf[i] = rand () & 0x7f;
+	}
+	for (i = 0; i < 64; i++) {
+		kwbuf[i][0] = 0x80 + i;
+		for (j = 1; j < 8; j++) {
+			kwbuf[i][j] = rand () & 0x7f;
+		}
+		add_kw (rs, &hits, r_search_keyword_new (kwbuf[i], 4 + i % 5, NULL, 0, NULL));
+	}
+	for (i = 0; i < size - 16 && nplanted < 512; i += 16 + rand () % 256) {
+		int k = rand () % 64;
+		memcpy (buf + i, kwbuf[k], 8);
+		planted[nplanted] = i;
+		planted_kw[nplanted++] = k;
+	}
+	r_search_begin (rs);
+	r_search_update_i (rs, 0LL, buf, size);
+	sort_hits (&hits);
+	mu_assert_eq (hits.count, nplanted, "every planted keyword found");
+	for (i = 0; i < nplanted; i++) {
+		mu_assert_eq ((int)hits.addr[i], planted[i], "hit address");
+		mu_assert_eq (hits.kw[i], planted_kw[i], "hit keyword");
+	}
+	r_search_free (rs);
+	free (buf);
+	mu_end;
+}
+
+bool test_r_search_regexp(void) {
+	static const char *elf = "ELF,e,e,e,ELF--fooo,elf";
+	Hits hits;
+	RSearch *rs = search_new (R_SEARCH_REGEXP, &hits);
+	add_kw (rs, &hits, r_search_keyword_new_str ("E.F", NULL, NULL, 1));
+	r_search_begin (rs);
+	r_search_update_i (rs, 0LL, (const ut8 *)elf, strlen (elf));
+	mu_assert_eq (hits.count, 3, "/E.F/i hits");
+	mu_assert_eq ((int)hits.addr[0], 0, "first ELF");
+	mu_assert_eq ((int)hits.addr[1], 10, "second ELF");
+	mu_assert_eq ((int)hits.addr[2], 20, "lowercase elf");
+	r_search_free (rs);
+	mu_end;
+}
+
+// db/cmd/regexp: /e /test/i on a block with "test" at 0 and "Test" at 444
+bool test_r_search_regexp_icase(void) {
+	ut8 *buf = calloc (1, 1024);
+	Hits hits;
+	RSearch *rs = search_new (R_SEARCH_REGEXP, &hits);
+	memcpy (buf, "test", 4);
+	memcpy (buf + 444, "Test", 4);
+	add_kw (rs, &hits, r_search_keyword_new_str ("test", NULL, NULL, 1));
+	r_search_begin (rs);
+	r_search_update_i (rs, 0LL, buf, 1024);
+	mu_assert_eq (hits.count, 2, "/test/i hits");
+	mu_assert_eq ((int)hits.addr[0], 0, "test");
+	mu_assert_eq ((int)hits.addr[1], 444, "Test");
+	r_search_free (rs);
+	free (buf);
+	mu_end;
+}
+
+// a pattern that is exponential for backtracking matchers over a long run of the same byte
+bool test_r_search_regexp_pathological(void) {
+	ut8 *buf = malloc (4096);
+	Hits hits;
+	RSearch *rs = search_new (R_SEARCH_REGEXP, &hits);
+	memset (buf, 'x', 4096);
+	buf[4095] = 0;
+	add_kw (rs, &hits, r_search_keyword_new_str ("(x+x+)+y", "", NULL, 0));
+	r_search_begin (rs);
+	r_search_update_i (rs, 0LL, buf, 4096);
+	mu_assert_eq (hits.count, 0, "no hits");
+	r_search_free (rs);
+	free (buf);
+	mu_end;
+}
+
+int all_tests() {
+	mu_run_test (test_r_search_keyword);
+	mu_run_test (test_r_search_distance);
+	mu_run_test (test_r_search_binmask);
+	mu_run_test (test_r_search_many_keywords);
+	mu_run_test (test_r_search_regexp);
+	mu_run_test (test_r_search_regexp_icase);
+	mu_run_test (test_r_search_regexp_pathological);
+	return tests_passed != tests_run;
+}
+
+int main(int argc, char **argv) {
+	return all_tests();
+}
@@ -189,6 +189,97 @@ bool test_r_str_rchr(void) {
 	mu_end;
 }
 
+// random text over a small alphabet, long enough to span any vector width
+static char *random_text(int len, const char *alphabet) {
+	char *s = malloc (len + 1);
+	int i, n = strlen (alphabet);
+	for (i = 0; i < len; i++) {
+		s[i] = alphabet[rand () % n];
+	}
+	s[len] = 0;
+	return s;
+}
+
+static int naive_count(const char *s, char ch) {
+	int n = 0;
+	for (; *s; s++) {
+		n += *s == ch;
+	}
+	return n;
+}
+
+static int naive_word_count(const char *s) {
+	int n = 0;
+	bool in_word = false;
+	for (; *s; s++) {
+		bool sep = *s == ' ' || *s == '\t' || *s == '\n';
+		if (!sep && !in_word) {
+			n++;
+		}
+		in_word = !sep;
+	}
+	return n;
+}
+
+// the r_str helpers agree with byte at a time references on random input
+bool test_r_str_random(void) {
+	char msg[64];
+	int round;
+	srand (1337);
+	for (round = 0; round < 200; round++) {
+		int len = rand () % 300, i;
+		char *s = random_text (len, "ab xy\t\n01");
+		char *copy = strdup (s);
+		snprintf (msg, sizeof (msg), "round %d, %d chars", round, len);
+
+		mu_assert_eq (r_str_char_count (s, 'a'), naive_count (s, 'a'), msg);
+		mu_assert_eq (r_str_char_count (s, ' '), naive_count (s, ' '), msg);
+		mu_assert_eq (r_str_word_count (s), naive_word_count (s), msg);
+		mu_assert (msg, r_str_lchr (s, 'x') == strrchr (s, 'x'));
+		mu_assert (msg, r_str_rchr (s, NULL, '1') == strrchr (s, '1'));
+
+		r_str_replace_char (copy, 'a', 'z');
+		for (i = 0; i < len; i++) {
+			mu_assert_eq (copy[i], s[i] == 'a'? 'z': s[i], msg);
+		}
+		mu_assert_eq (copy[len], 0, msg);
+
+		strcpy (copy, s);
+		mu_assert_eq (r_str_split (copy, '\n'), naive_count (s, '\n'), msg);
+		for (i = 0; i < len; i++) {
+			mu_assert_eq (copy[i], s[i] == '\n'? 0: s[i], msg);
+		}
+		free (copy);
+		free (s);
+	}
+	mu_end;
+}
+
+// single spaced words, as in a command line, come back one by one
+bool test_r_str_tokenize_words(void) {
+	static const char *words[] = { "pd", "10", "@", "sym.main", "~call", "[1]", "0x400000" };
+	char line[128] = {0}, msg[32];
+	int n, i;
+	for (n = 1; n <= R_ARRAY_SIZE (words); n++) {
+		char *s;
+		line[0] = 0;
+		for (i = 0; i < n; i++) {
+			strcat (line, words[i]);
+			if (i + 1 < n) {
+				strcat (line, " ");
+			}
+		}
+		s = strdup (line);
+		snprintf (msg, sizeof (msg), "%d words", n);
+		mu_assert_eq (r_str_word_set0 (s), n - 1, msg);
+		for (i = 0; i < n; i++) {
+			mu_assert_streq (r_str_word_get0 (s, i), words[i], msg);
+		}
+		free (s);
+	}
+	mu_end;
+}
+
 bool all_tests() {
 	mu_run_test(test_r_str_replace_char_once);
 	mu_run_test(test_r_str_replace_char);
@@ -206,6 +297,8 @@ bool all_tests() {
 	mu_run_test(test_r_sub_str_lchr);
 	mu_run_test(test_r_sub_str_rchr);
 	mu_run_test(test_r_str_rchr);
+	mu_run_test(test_r_str_random);
+	mu_run_test(test_r_str_tokenize_words);
 	return tests_passed != tests_run;
 }
 
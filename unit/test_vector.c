@@ -528,6 +528,82 @@ static bool test_vector_shrink() {
 	mu_end;
 }
 
+// growth, shrink and clone around the small sizes most vectors never leave
+static bool test_vector_small_boundaries() {
+	RVector v;
+	ut32 e, i, j;
+	size_t capacity = 0;
+	r_vector_init (&v, sizeof (ut32), NULL, NULL);
+	for (i = 0; i < 17; i++) {
+		r_vector_push (&v, &i);
+		mu_assert_eq_fmt (v.len, (size_t)i + 1, "small push => len", "%lu");
+		mu_assert ("small push => capacity >= len", v.capacity >= v.len);
+		mu_assert ("small push => capacity never shrinks", v.capacity >= capacity);
+		capacity = v.capacity;
+		for (j = 0; j <= i; j++) {
+			mu_assert_eq (*((ut32 *)r_vector_index_ptr (&v, j)), j, "small push => content");
+		}
+	}
+	for (i = 17; i > 0; i--) {
+		r_vector_pop (&v, &e);
+		mu_assert_eq (e, i - 1, "small pop => value");
+		mu_assert_eq_fmt (v.len, (size_t)i - 1, "small pop => len", "%lu");
+		mu_assert_eq_fmt (v.capacity, capacity, "small pop => capacity kept", "%lu");
+	}
+	mu_assert ("small pop => empty", r_vector_empty (&v));
+	r_vector_clear (&v);
+
+	for (i = 0; i <= 8; i++) {
+		RVector *clone;
+		init_test_vector (&v, i, 3, NULL, NULL);
+		r_vector_shrink (&v);
+		mu_assert_eq_fmt (v.capacity, (size_t)i, "small shrink => capacity", "%lu");
+		clone = r_vector_clone (&v);
+		mu_assert ("small clone", clone);
+		mu_assert_eq_fmt (clone->len, (size_t)i, "small clone => len", "%lu");
+		for (j = 0; j < i; j++) {
+			*((ut32 *)r_vector_index_ptr (clone, j)) = 1337;
+			mu_assert_eq (*((ut32 *)r_vector_index_ptr (&v, j)), j, "small clone => independent content");
+		}
+		e = 42;
+		r_vector_push (&v, &e);
+		mu_assert_eq_fmt (v.len, (size_t)i + 1, "push after shrink => len", "%lu");
+		mu_assert_eq (*((ut32 *)r_vector_index_ptr (&v, i)), 42, "push after shrink => content");
+		r_vector_free (clone);
+		r_vector_clear (&v);
+	}
+	mu_end;
+}
+
+// insert and remove at every position of tiny vectors against a plain array
+static bool test_vector_small_insert_remove() {
+	ut32 expected[9], e, len, pos, i;
+	RVector v;
+	for (len = 0; len <= 8; len++) {
+		for (pos = 0; pos <= len; pos++) {
+			init_test_vector (&v, len, 0, NULL, NULL);
+			for (i = 0; i < len; i++) {
+				expected[i] = i;
+			}
+			memmove (expected + pos + 1, expected + pos, (len - pos) * sizeof (ut32));
+			expected[pos] = 1337;
+			e = 1337;
+			r_vector_insert (&v, pos, &e);
+			mu_assert_eq_fmt (v.len, (size_t)len + 1, "small insert => len", "%lu");
+			mu_assert_memeq ((ut8 *)v.a, (ut8 *)expected, (len + 1) * sizeof (ut32), "small insert => content");
+
+			r_vector_remove_at (&v, pos, &e);
+			mu_assert_eq (e, 1337, "small remove => value");
+			mu_assert_eq_fmt (v.len, (size_t)len, "small remove => len", "%lu");
+			for (i = 0; i < len; i++) {
+				mu_assert_eq (*((ut32 *)r_vector_index_ptr (&v, i)), i, "small remove => content");
+			}
+			r_vector_clear (&v);
+		}
+	}
+	mu_end;
+}
+
 static bool test_pvector_init() {
 	RPVector v;
 	r_pvector_init (&v, (void *)1337);
@@ -911,6 +987,39 @@ static bool test_pvector_sort() {
 	mu_end;
 }
 
+static int cmp_ptr_value(const void *a, const void *b) {
+	return ((size_t)a > (size_t)b) - ((size_t)a < (size_t)b);
+}
+
+static int cmp_size_t(const void *a, const void *b) {
+	return cmp_ptr_value ((void *)*(const size_t *)a, (void *)*(const size_t *)b);
+}
+
+static bool test_pvector_sort_random() {
+	static const size_t sizes[] = { 0, 1, 2, 7, 100, 100000 };
+	size_t i, j;
+	srand (1337);
+	for (i = 0; i < R_ARRAY_SIZE (sizes); i++) {
+		size_t *expected = calloc (sizes[i] + 1, sizeof (size_t));
+		RPVector v;
+		r_pvector_init (&v, NULL);
+		for (j = 0; j < sizes[i]; j++) {
+			// plenty of duplicates
+			expected[j] = rand () % (sizes[i] / 2 + 1);
+			r_pvector_push (&v, (void *)expected[j]);
+		}
+		qsort (expected, sizes[i], sizeof (size_t), cmp_size_t);
+		r_pvector_sort (&v, cmp_ptr_value);
+		mu_assert_eq_fmt (v.v.len, sizes[i], "sort len", "%lu");
+		for (j = 0; j < sizes[i]; j++) {
+			mu_assert_eq_fmt ((size_t)r_pvector_at (&v, j), expected[j], "same result as qsort", "%lu");
+		}
+		r_pvector_clear (&v);
+		free (expected);
+	}
+	mu_end;
+}
+
 static bool test_pvector_foreach() {
 	RPVector v;
 	init_test_pvector2 (&v, 5, 5);
@@ -984,6 +1093,8 @@ static int all_tests() {
 	mu_run_test (test_vector_push_front);
 	mu_run_test (test_vector_reserve);
 	mu_run_test (test_vector_shrink);
+	mu_run_test (test_vector_small_boundaries);
+	mu_run_test (test_vector_small_insert_remove);
 
 	mu_run_test (test_pvector_init);
 	mu_run_test (test_pvector_new);
@@ -1000,6 +1111,7 @@ static int all_tests() {
 	mu_run_test (test_pvector_push);
 	mu_run_test (test_pvector_push_front);
 	mu_run_test (test_pvector_sort);
+	mu_run_test (test_pvector_sort_random);
 	mu_run_test (test_pvector_foreach);
 	mu_run_test (test_pvector_upper_lower_bound);
 